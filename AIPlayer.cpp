@@ -1,132 +1,696 @@
 #include "AIPlayer.h"
-#include "Board.h"
 #include <iostream>
 #include <algorithm>
+#include <bit>
+#include <climits>
+#include <type_traits>
+#include "OpeningBook.h"
+#include "SolvedTable.h"
+#include "Tablebase4x4.h"
 
-constexpr int WIN_SCORE = 10;   // AI wins
-constexpr int LOSE_SCORE = -10; // Player wins
-constexpr int DRAW_SCORE = 0;   // Draw
+// A win must outscore the deepest possible search and every heuristic score, so depth-adjusted wins
+// never drop to a draw, a heuristic estimate, or below.
+constexpr int WIN_SCORE = 100000;              // AI wins
+constexpr int LOSE_SCORE = -WIN_SCORE;         // Player wins
+constexpr int DRAW_SCORE = 0;                  // Draw
+constexpr int INFINITY_SCORE = 1000000;        // Bound larger than any score
+
+// Scores at or beyond this are wins or losses; they are stored relative to their position
+template <typename TBoard>
+constexpr int WIN_THRESHOLD = WIN_SCORE - TBoard::SIZE;
+
+// Bonus for a threat the opponent cannot parry: it outweighs the pattern score of every line together
+template <typename TBoard>
+constexpr int FORCED_THREAT_SCORE = TBoard::LINE_COUNT * TBoard::MAX_PATTERN_SCORE;
+
+// Even with every line one mark short of a win plus a forced threat, a heuristic score stays below any proven result
+template <typename TBoard>
+constexpr bool HEURISTIC_FITS = TBoard::LINE_COUNT * TBoard::MAX_PATTERN_SCORE + FORCED_THREAT_SCORE<TBoard> < WIN_THRESHOLD<TBoard>;
+
+// Constructor that sets the player's symbol and budget and creates one search context per thread.
+// All threads share one transposition table of the configured size.
+template <typename TBoard>
+AIPlayer<TBoard>::AIPlayer(const CellState ac_player, const SearchOptions& a_options)
+    : Player<TBoard>(ac_player), m_moveTime(a_options.moveTime),
+      m_nodeLimit(a_options.nodeLimit != 0 ? a_options.nodeLimit : UINT64_MAX),
+      m_maxDepth(a_options.maxDepth > 0 ? a_options.maxDepth : INT_MAX), m_lazySmp(a_options.lazySmp),
+      m_logStats(a_options.logStats), m_table(a_options.tableMegabytes), m_tablebase(a_options.tablebase4x4), m_book(a_options.book) {
+    const int li_threads = std::max(a_options.threads, 1);
+    for (int i = 0; i < li_threads; ++i) {
+        m_contexts.push_back(std::make_unique<SearchContext>());
+    }
+    if (li_threads > 1) {
+        m_pool = std::make_unique<ThreadPool>(li_threads);
+    }
+}
+
+// Destructor that waits for a pondering search to stop before the tables it uses are freed
+template <typename TBoard>
+AIPlayer<TBoard>::~AIPlayer() {
+    stopPondering();
+}
 
 /**
  * Evaluates the current state of the board.
  * The function returns a score based on the state:
- * +10 for AI's victory, -10 for player's victory, and 0 for a draw.
+ * WIN_SCORE for AI's victory, LOSE_SCORE for player's victory, and 0 for a draw.
  *
  * @param a_board The current game board
  * @return An integer score representing the board's state
  */
-int AIPlayer::evaluateBoard(const Board &a_board) const {
-    // Check rows, columns, and diagonals for a win
-    for (int i = 0; i < 3; i++) {
-        // Check rows
-        if (a_board.getSymbol(i, 0) == a_board.getSymbol(i, 1) && a_board.getSymbol(i, 1) == a_board.getSymbol(i, 2)) {
-            if (a_board.getSymbol(i, 0) == m_player) return WIN_SCORE;  // AI wins
-            else if (a_board.getSymbol(i, 0) != CellState::EMPTY) return LOSE_SCORE; // Player wins
+template <typename TBoard>
+int AIPlayer<TBoard>::evaluateBoard(const TBoard &a_board) const {
+    // Check rows, columns, and diagonals for a win using the board's line masks
+    if (a_board.checkWin(m_player)) return WIN_SCORE;  // AI wins
+    if (a_board.checkWin(opponentOf(m_player))) return LOSE_SCORE; // Player wins
+
+    // If no winner, return 0 for a draw
+    return DRAW_SCORE;
+}
+
+/**
+ * Estimates a position the search stops at before the game is over.
+ * The board keeps the pattern score of every win line up to date as moves are made: lines open to only one
+ * player count for that player, eight times more for each extra mark and twice as much for an open run, and
+ * lines blocked by both players count for nothing. On top of that, a player to move who can complete a line,
+ * or an opponent with two different cells that complete a line, is about to win whatever the reply.
+ *
+ * @param a_board The current game board
+ * @return A score strictly between LOSE_SCORE and WIN_SCORE, positive when the AI stands better
+ */
+template <typename TBoard>
+int AIPlayer<TBoard>::evaluateHeuristic(const TBoard &a_board) const {
+    static_assert(HEURISTIC_FITS<TBoard>, "Heuristic scores must stay below the win threshold");
+    const int li_sign = m_player == CellState::X ? 1 : -1;
+    int li_score = li_sign * a_board.getPatternScore();
+
+    const bool lb_xToMove = std::popcount(a_board.getMask(CellState::X)) == std::popcount(a_board.getMask(CellState::O));
+    const CellState lc_toMove = lb_xToMove ? CellState::X : CellState::O;
+    const int li_toMoveSign = lc_toMove == m_player ? 1 : -1;
+    if (a_board.getThreatCount(lc_toMove) > 0) {
+        li_score += li_toMoveSign * FORCED_THREAT_SCORE<TBoard>;  // Completes a line on this move
+    } else if (std::popcount(a_board.getThreatCells(opponentOf(lc_toMove))) >= 2) {
+        li_score -= li_toMoveSign * FORCED_THREAT_SCORE<TBoard>;  // Only one of the two cells can be blocked
+    }
+    return li_score;
+}
+
+/**
+ * Computes the static search order of the cells: cells on the most win lines first, ties broken by
+ * distance from the centre and then by move number. On 3x3 this is the centre, then the corners, then the edges.
+ *
+ * @return The move numbers (1 to SIZE) in search order
+ */
+template <typename TBoard>
+constexpr std::array<std::uint8_t, TBoard::SIZE> makeMoveOrder() {
+    std::array<std::uint8_t, TBoard::SIZE> l_order{};
+    for (int i = 0; i < TBoard::SIZE; ++i) {
+        l_order[i] = static_cast<std::uint8_t>(i + 1);
+    }
+    const auto lf_key = [](const int ai_move) {
+        const int li_row = (ai_move - 1) / TBoard::COLS, li_col = (ai_move - 1) % TBoard::COLS;
+        const int li_rowDistance = 2 * li_row - (TBoard::ROWS - 1), li_colDistance = 2 * li_col - (TBoard::COLS - 1);
+        const int li_distance = li_rowDistance * li_rowDistance + li_colDistance * li_colDistance;
+        return -TBoard::CELL_LINES[ai_move - 1].count * 10000 + li_distance * 100 + ai_move;
+    };
+    std::sort(l_order.begin(), l_order.end(), [&](const int a, const int b) { return lf_key(a) < lf_key(b); });
+    return l_order;
+}
+
+template <typename TBoard>
+constexpr auto MOVE_ORDER = makeMoveOrder<TBoard>();
+
+/**
+ * Lists the legal moves in search order. The best move stored in the transposition table comes first.
+ * On the larger boards it is followed by the killer moves of this ply and then the other moves sorted
+ * by history score; otherwise the static MOVE_ORDER is used as is.
+ *
+ * @param a_context The searching thread, whose board, killer moves, and history scores are used
+ * @param ai_depth The current depth of recursion, which indexes the killer moves
+ * @param ab_isMaximizingPlayer Whether the AI is to move, which selects the history scores
+ * @param ai_firstMove A move to try before all others, or 0
+ * @param a_moves Receives the legal moves in search order
+ * @return The number of legal moves
+ */
+template <typename TBoard>
+int AIPlayer<TBoard>::orderMoves(const SearchContext &a_context, const int ai_depth, const bool ab_isMaximizingPlayer, const int ai_firstMove,
+                                 std::array<std::uint8_t, TBoard::SIZE> &a_moves) const {
+    int li_count = 0;
+    for (const std::uint8_t lu_move : MOVE_ORDER<TBoard>) {
+        if (a_context.board.checkMove(lu_move)) {
+            a_moves[li_count++] = lu_move;
         }
+    }
+
+    if constexpr (USE_MOVE_HEURISTICS) {
+        const auto& l_scores = a_context.historyScores[ab_isMaximizingPlayer ? 0 : 1];
+        const auto& l_killers = a_context.killers[ai_depth];
+        const auto lf_rank = [&](const int ai_move) -> std::uint64_t {
+            if (ai_move == l_killers[0]) return UINT64_MAX - 1;
+            if (ai_move == l_killers[1]) return UINT64_MAX - 2;
+            return l_scores[ai_move - 1];
+        };
+        // Stable, so moves without a score keep the static order
+        std::stable_sort(a_moves.begin(), a_moves.begin() + li_count, [&](const int a, const int b) { return lf_rank(a) > lf_rank(b); });
+    }
 
-        // Check columns
-        if (a_board.getSymbol(0, i) == a_board.getSymbol(1, i) && a_board.getSymbol(1, i) == a_board.getSymbol(2, i)) {
-            if (a_board.getSymbol(0, i) == m_player) return WIN_SCORE;  // AI wins
-            else if (a_board.getSymbol(0, i) != CellState::EMPTY) return LOSE_SCORE; // Player wins
+    // The stored best move refuted this position before and usually does again
+    const auto l_first = std::find(a_moves.begin(), a_moves.begin() + li_count, ai_firstMove);
+    if (l_first != a_moves.begin() + li_count) {
+        for (auto l_slot = l_first; l_slot != a_moves.begin(); --l_slot) {
+            *l_slot = *(l_slot - 1);
         }
+        a_moves[0] = ai_firstMove;
     }
+    return li_count;
+}
 
-    // Check diagonals
-    if (a_board.getSymbol(0, 0) == a_board.getSymbol(1, 1) && a_board.getSymbol(1, 1) == a_board.getSymbol(2, 2)) {
-        if (a_board.getSymbol(0, 0) == m_player) return WIN_SCORE;  // AI wins
-        else if (a_board.getSymbol(0, 0) != CellState::EMPTY) return LOSE_SCORE; // Player wins
+/**
+ * Records a move that caused a beta or alpha cutoff: it becomes the first killer move of its ply,
+ * and its history score grows with the size of the subtree it pruned.
+ *
+ * @param a_context The searching thread
+ * @param ai_depth The current depth of recursion
+ * @param ab_isMaximizingPlayer Whether the AI made the move
+ * @param ai_move The move that caused the cutoff
+ */
+template <typename TBoard>
+void AIPlayer<TBoard>::recordCutoff(SearchContext &a_context, const int ai_depth, const bool ab_isMaximizingPlayer, const int ai_move) {
+    if constexpr (USE_MOVE_HEURISTICS) {
+        auto& l_killers = a_context.killers[ai_depth];
+        if (l_killers[0] != ai_move) {
+            l_killers[1] = l_killers[0];
+            l_killers[0] = static_cast<std::uint8_t>(ai_move);
+        }
+        const std::uint32_t lu_remaining = static_cast<std::uint32_t>(TBoard::SIZE - ai_depth);
+        a_context.historyScores[ab_isMaximizingPlayer ? 0 : 1][ai_move - 1] += lu_remaining * lu_remaining;
     }
-    if (a_board.getSymbol(0, 2) == a_board.getSymbol(1, 1) && a_board.getSymbol(1, 1) == a_board.getSymbol(2, 0)) {
-        if (a_board.getSymbol(0, 2) == m_player) return WIN_SCORE;  // AI wins
-        else if (a_board.getSymbol(0, 2) != CellState::EMPTY) return LOSE_SCORE; // Player wins
+}
+
+/**
+ * Adds a batch of 1024 nodes to the shared count and stops the search once the node limit or the deadline is reached,
+ * or once pondering is called off. Reading the clock only once per batch keeps the overshoot well below a millisecond.
+ */
+template <typename TBoard>
+void AIPlayer<TBoard>::checkBudget() {
+    const std::uint64_t lu_total = m_totalNodes.fetch_add(1024, std::memory_order_relaxed) + 1024;
+    if (lu_total >= m_nodeLimit || std::chrono::steady_clock::now() >= m_deadline || m_ponderStopped.load(std::memory_order_relaxed)) {
+        m_aborted.store(true, std::memory_order_relaxed);
     }
+}
 
-    // If no winner, return 0 for a draw
-    return DRAW_SCORE;
+/**
+ * Checks if a thread has to unwind its search. Every thread stops once the budget is spent;
+ * a Lazy SMP helper also stops as soon as the main thread has finished the iteration it was helping with.
+ *
+ * @param a_context The searching thread
+ * @return true if the thread's current search is to be abandoned
+ */
+template <typename TBoard>
+bool AIPlayer<TBoard>::isStopped(const SearchContext &a_context) const {
+    return m_aborted.load(std::memory_order_relaxed) || (a_context.helper && m_helpersStopped.load(std::memory_order_relaxed));
 }
 
 /**
- * Minimax algorithm to calculate the optimal move for the AI player.
- * This is a recursive function that explores all possible moves and returns
+ * Minimax algorithm with alpha-beta pruning to calculate the optimal move for the AI player.
+ * This is a recursive function that explores the possible moves and returns
  * a score based on whether the AI or player wins, or if the game ends in a draw.
+ * Branches that cannot change the result are cut off: a score inside (alpha, beta) is exact,
+ * a score at or below alpha is an upper bound, and a score at or above beta is a lower bound.
+ * Positions at the depth limit of the thread's current iteration are scored by evaluateHeuristic. Once the
+ * thread is stopped the search unwinds with meaningless scores without storing them, and the caller discards the iteration.
  *
- * @param a_board The current game board
+ * @param a_context The searching thread; the current game board is a_context.board
  * @param ai_depth The current depth of recursion (how many moves ahead)
  * @param ab_isMaximizingPlayer Boolean flag to indicate if the current player is the maximizing player (AI)
+ * @param ai_alpha The score the AI is already guaranteed elsewhere in the tree
+ * @param ai_beta The score the player is already guaranteed elsewhere in the tree
  * @return The score of the board state, used to determine the best move
  */
-int AIPlayer::minimax(Board &a_board, const int ai_depth, const bool ab_isMaximizingPlayer) {
-    const int li_score = evaluateBoard(a_board);  // Get the current score of the board state
+template <typename TBoard>
+int AIPlayer<TBoard>::minimax(SearchContext &a_context, const int ai_depth, const bool ab_isMaximizingPlayer, int ai_alpha, int ai_beta) {
+    if ((++a_context.nodes & 1023) == 0) checkBudget();
+    if (isStopped(a_context)) return DRAW_SCORE;
+
+    TBoard &l_board = a_context.board;
+    const int li_score = evaluateBoard(l_board);  // Get the current score of the board state
     if (li_score == WIN_SCORE) return li_score - ai_depth;  // AI wins, prefer faster wins
     if (li_score == LOSE_SCORE) return li_score + ai_depth;  // Player wins, prefer slower losses
-    if (a_board.checkDraw()) return DRAW_SCORE;  // Draw condition
+    if (l_board.checkDraw()) return DRAW_SCORE;  // Draw condition
+
+    if (ai_depth >= a_context.depthLimit) return evaluateHeuristic(l_board);  // Depth limit of this iteration
+
+    // Plies left to search: up to the depth limit, or to the end of the game if that comes first
+    const int li_remaining = std::min(std::popcount(l_board.getMask(CellState::EMPTY)), a_context.depthLimit - ai_depth);
+
+    // Use a stored result if it settles the position within the window, otherwise just try its best move first
+    const int li_alphaIn = ai_alpha, li_betaIn = ai_beta;
+    int li_firstMove = 0;
+    TranspositionTable::Entry l_entry;
+    const bool lb_found = m_table.probe(l_board.getHash(), l_entry);
+    if constexpr (SEARCH_STATS_ENABLED) {
+        ++a_context.tableProbes;
+        a_context.tableHits += lb_found;
+    }
+    if (lb_found) {
+        li_firstMove = l_entry.move;
+        if (l_entry.depth >= li_remaining) {
+            const int li_value = TranspositionTable::fromTableScore(l_entry.value, ai_depth, WIN_THRESHOLD<TBoard>);
+            if (l_entry.bound == TranspositionTable::Bound::EXACT) return li_value;
+            if (l_entry.bound == TranspositionTable::Bound::LOWER && li_value >= ai_beta) return li_value;
+            if (l_entry.bound == TranspositionTable::Bound::UPPER && li_value <= ai_alpha) return li_value;
+        }
+    }
+
+    std::array<std::uint8_t, TBoard::SIZE> l_moves;
+    const int li_count = orderMoves(a_context, ai_depth, ab_isMaximizingPlayer, li_firstMove, l_moves);
+    int li_best = ab_isMaximizingPlayer ? -INFINITY_SCORE : INFINITY_SCORE;  // Start with the worst possible score for the player to move
+    int li_bestMove = 0;
 
     if (ab_isMaximizingPlayer) {
-        int li_best = -1000;  // Start with the worst possible score for AI
-
-        // Explore all possible moves for the AI (maximizing player)
-        for (int i = 1; i <= 9; i++) {
-            if (a_board.checkMove(i)) {
-                a_board.makeMove(m_player, i);  // Make the AI move
-                li_best = std::max(li_best, minimax(a_board, ai_depth + 1, false));  // Call minimax recursively for the opponent
-                a_board.makeMove(CellState::EMPTY, i);  // Undo the move
+        // Explore the possible moves for the AI (maximizing player)
+        for (int i = 0; i < li_count; i++) {
+            l_board.pushMove(m_player, l_moves[i]);  // Make the AI move
+            const int li_value = minimax(a_context, ai_depth + 1, false, ai_alpha, ai_beta);  // Call minimax recursively for the opponent
+            l_board.popMove();  // Undo the move
+            if (isStopped(a_context)) return DRAW_SCORE;
+            if (li_value > li_best) {
+                li_best = li_value;
+                li_bestMove = l_moves[i];
+            }
+            ai_alpha = std::max(ai_alpha, li_best);
+            if (ai_alpha >= ai_beta) {
+                recordCutoff(a_context, ai_depth, true, l_moves[i]);
+                if constexpr (SEARCH_STATS_ENABLED) {
+                    ++a_context.cutoffs;
+                    a_context.firstMoveCutoffs += i == 0;
+                }
+                break;  // The player already has a better option elsewhere
             }
         }
-        return li_best;
     } else {
-        int li_best = 1000;  // Start with the worst possible score for the player
-
-        // Explore all possible moves for the player (minimizing player)
-        for (int i = 1; i <= 9; i++) {
-            if (a_board.checkMove(i)) {
-                a_board.makeMove(CellState::X, i);  // Make the player move
-                li_best = std::min(li_best, minimax(a_board, ai_depth + 1, true));  // Call minimax recursively for AI
-                a_board.makeMove(CellState::EMPTY, i);  // Undo the move
+        // Explore the possible moves for the player (minimizing player)
+        for (int i = 0; i < li_count; i++) {
+            l_board.pushMove(opponentOf(m_player), l_moves[i]);  // Make the player move
+            const int li_value = minimax(a_context, ai_depth + 1, true, ai_alpha, ai_beta);  // Call minimax recursively for AI
+            l_board.popMove();  // Undo the move
+            if (isStopped(a_context)) return DRAW_SCORE;
+            if (li_value < li_best) {
+                li_best = li_value;
+                li_bestMove = l_moves[i];
+            }
+            ai_beta = std::min(ai_beta, li_best);
+            if (ai_alpha >= ai_beta) {
+                recordCutoff(a_context, ai_depth, false, l_moves[i]);
+                if constexpr (SEARCH_STATS_ENABLED) {
+                    ++a_context.cutoffs;
+                    a_context.firstMoveCutoffs += i == 0;
+                }
+                break;  // The AI already has a better option elsewhere
             }
         }
-        return li_best;
     }
+
+    // A score outside the original window is only a bound on the true score
+    const TranspositionTable::Bound lc_bound = li_best <= li_alphaIn ? TranspositionTable::Bound::UPPER
+                                             : li_best >= li_betaIn ? TranspositionTable::Bound::LOWER
+                                             : TranspositionTable::Bound::EXACT;
+    m_table.store(l_board.getHash(), TranspositionTable::toTableScore(li_best, ai_depth, WIN_THRESHOLD<TBoard>),
+                  lc_bound, li_remaining, li_bestMove);
+    return li_best;
 }
 
 /**
- * Finds the best move for the AI using the minimax algorithm.
- * It evaluates all possible moves and returns the one with the best score.
+ * Searches the root moves with iterative deepening: each iteration searches one ply deeper than the last,
+ * starting with the previous best move, until the whole game tree fits or the budget runs out.
+ * An interrupted iteration is discarded and the move of the last completed one is returned.
+ * Ties go to the lowest move number: each move is searched with alpha just below the best score so far,
+ * so an equal score is still computed exactly. The final, full-depth iteration therefore picks
+ * exactly the move a plain minimax would.
+ *
+ * With several threads, each root move is a task on the thread pool, searched on the thread's own board.
+ * The best (score, move) pair found so far is shared through one atomic, packed so that a higher score,
+ * and then a lower move number, compares greater. A thread may start from a stale best score, which only
+ * widens its window, so every iteration still ends with the same move as a single-threaded one.
+ *
+ * In Lazy SMP mode the main thread instead searches every root move itself, exactly as on one thread,
+ * while the helpers search the same position, half of them one ply deeper and each starting at a different
+ * root move. Their results reach the main thread only through the shared transposition table, and they are
+ * stopped as soon as the main thread finishes the iteration.
  *
  * @param a_board The current game board
- * @return The best move for the AI (position between 1 and 9)
- */
-int AIPlayer::findBestMove(Board &a_board) {
-    int li_bestVal = -1000;  // Start with the worst possible score for AI
-    int li_bestMove = -1;
-
-    // Explore all possible moves for the AI and select the one with the best score
-    for (int i = 1; i <= 9; i++) {
-        if (a_board.checkMove(i)) {
-            a_board.makeMove(m_player, i);  // Make the AI move
-            const int li_moveVal = minimax(a_board, 0, false);  // Evaluate the move
-            a_board.makeMove(CellState::EMPTY, i);  // Undo the move
-            if (li_moveVal > li_bestVal) {
-                li_bestMove = i;  // Update best move if this one is better
-                li_bestVal = li_moveVal;  // Update best value
+ * @return The best move for the AI (position between 1 and SIZE)
+ */
+template <typename TBoard>
+int AIPlayer<TBoard>::searchBestMove(TBoard &a_board) {
+    const auto l_start = std::chrono::steady_clock::now();
+    m_deadline = l_start + m_moveTime;
+    m_totalNodes.store(0, std::memory_order_relaxed);
+    m_aborted.store(false, std::memory_order_relaxed);
+    m_lastValue = 0;
+    m_lastDepth = 0;
+    m_stats = SearchStats{};
+    m_rootMoves = {};
+    m_table.newSearch();
+    for (const auto& l_context : m_contexts) {
+        l_context->board = a_board;
+        l_context->nodes = 0;
+        l_context->killers = {};
+        l_context->historyScores = {};
+        l_context->tableProbes = l_context->tableHits = l_context->cutoffs = l_context->firstMoveCutoffs = 0;
+    }
+
+    // Collect the symmetries that map the position onto itself. Moves they map onto each other
+    // have the same value, so only the lowest-numbered move of each such group is searched.
+    int l_symmetries[TBoard::SYMMETRY_COUNT];
+    int li_symmetryCount = 0;
+    for (int t = 1; t < TBoard::SYMMETRY_COUNT; t++) {
+        if (a_board.isSymmetric(t)) {
+            l_symmetries[li_symmetryCount++] = t;
+        }
+    }
+
+    std::array<std::uint8_t, TBoard::SIZE> l_moves;
+    int li_count = 0;
+    for (const std::uint8_t lu_move : MOVE_ORDER<TBoard>) {
+        bool lb_duplicate = false;
+        for (int s = 0; s < li_symmetryCount && !lb_duplicate; s++) {
+            lb_duplicate = TBoard::transformMove(lu_move, l_symmetries[s]) < lu_move;  // An equivalent lower move is searched instead
+        }
+        if (!lb_duplicate && a_board.checkMove(lu_move)) {
+            l_moves[li_count++] = lu_move;
+        }
+    }
+
+    // (score, move) packed into one integer: score * 256 + (255 - move)
+    const auto lf_pack = [](const int ai_value, const int ai_move) { return static_cast<std::int64_t>(ai_value) * 256 + (255 - ai_move); };
+    std::atomic<std::int64_t> l_iterationBest{0};
+
+    // Searches one root move on a thread's own board and merges its score into a_best
+    const auto lf_searchRootMove = [&](SearchContext &a_context, const int ai_move, std::atomic<std::int64_t> &a_best) {
+        if (isStopped(a_context)) return;
+        const int li_alpha = static_cast<int>(a_best.load(std::memory_order_relaxed) >> 8) - 1;  // Just below the best score so far
+        [[maybe_unused]] const auto l_moveStart = SEARCH_STATS_ENABLED ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+        [[maybe_unused]] const std::uint64_t lu_nodesBefore = a_context.nodes;
+        a_context.board.pushMove(m_player, ai_move);  // Make the AI move
+        const int li_moveVal = minimax(a_context, 1, false, li_alpha, INFINITY_SCORE);  // Evaluate the move
+        a_context.board.popMove();  // Undo the move
+        if constexpr (SEARCH_STATS_ENABLED) {
+            // Each root move is searched by one task at a time, so its entry has a single writer
+            if (!a_context.helper) {
+                SearchStats::RootMove& l_rootMove = m_rootMoves[ai_move - 1];
+                l_rootMove.move = ai_move;
+                l_rootMove.time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_moveStart);
+                l_rootMove.nodes += a_context.nodes - lu_nodesBefore;
             }
         }
+        if (isStopped(a_context)) return;
+
+        // Keep the better of the two; a failed-low score is below the best and never replaces it
+        const std::int64_t li_packed = lf_pack(li_moveVal, ai_move);
+        std::int64_t li_current = a_best.load(std::memory_order_relaxed);
+        while (li_packed > li_current && !a_best.compare_exchange_weak(li_current, li_packed, std::memory_order_relaxed)) {
+        }
+    };
+
+    // Root split: every root move is a task, searched by whichever worker picks it up
+    const ThreadPool::Task lf_splitTask = [&](const int ai_index, const int ai_worker) {
+        lf_searchRootMove(*m_contexts[ai_worker], l_moves[ai_index], l_iterationBest);
+    };
+
+    const int li_empty = std::popcount(a_board.getMask(CellState::EMPTY));
+    int li_depthLimit = 1;
+
+    // Lazy SMP: task 0 is the main search of the iteration, every other task a helper that keeps deepening
+    // from li_depthLimit (odd tasks from one ply deeper) until the main search is done
+    const ThreadPool::Task lf_lazyTask = [&](const int ai_index, const int ai_worker) {
+        SearchContext &l_context = *m_contexts[ai_worker];
+        l_context.helper = ai_index != 0;
+        if (!l_context.helper) {
+            for (int i = 0; i < li_count; i++) {
+                lf_searchRootMove(l_context, l_moves[i], l_iterationBest);
+            }
+            m_helpersStopped.store(true, std::memory_order_relaxed);
+            return;
+        }
+        for (l_context.depthLimit = li_depthLimit + ai_index % 2; l_context.depthLimit <= li_empty && !isStopped(l_context); ++l_context.depthLimit) {
+            std::atomic<std::int64_t> l_helperBest{lf_pack(-INFINITY_SCORE, 255)};
+            for (int i = 0; i < li_count; i++) {
+                lf_searchRootMove(l_context, l_moves[(i + ai_index) % li_count], l_helperBest);
+            }
+        }
+    };
+
+    int li_bestMove = li_count > 0 ? l_moves[0] : -1;  // Always have a legal answer, even if the first iteration is cut short
+    std::uint64_t lu_previousNodes = 0;
+
+    for (; li_depthLimit <= std::min(li_empty, m_maxDepth); ++li_depthLimit) {
+        l_iterationBest.store(lf_pack(-INFINITY_SCORE, 255), std::memory_order_relaxed);
+        for (const auto& l_context : m_contexts) {
+            l_context->depthLimit = li_depthLimit;
+        }
+
+        // Search the previous best move first so a good bound is available early
+        std::stable_partition(l_moves.begin(), l_moves.begin() + li_count, [li_bestMove](const int ai_move) { return ai_move == li_bestMove; });
+        if (m_pool && m_lazySmp) {
+            m_helpersStopped.store(false, std::memory_order_relaxed);
+            m_pool->parallelFor(m_pool->getThreadCount(), lf_lazyTask);
+        } else if (m_pool) {
+            m_pool->parallelFor(li_count, lf_splitTask);
+        } else {
+            for (int i = 0; i < li_count; i++) {
+                lf_splitTask(i, 0);
+            }
+        }
+
+        if (m_aborted.load(std::memory_order_relaxed)) break;  // Keep the move from the last completed iteration
+        const std::int64_t li_best = l_iterationBest.load(std::memory_order_relaxed);
+        li_bestMove = 255 - static_cast<int>(li_best & 0xFF);
+        m_lastValue = static_cast<int>(li_best >> 8);
+        m_lastDepth = li_depthLimit;
+        const std::uint64_t lu_nodes = getNodeCount();
+        m_stats.iterationNodes.push_back(lu_nodes - lu_previousNodes);
+        lu_previousNodes = lu_nodes;
+    }
+
+    m_stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_start);
+    m_stats.nodes = getNodeCount();
+    m_stats.depth = m_lastDepth;
+    m_stats.value = m_lastValue;
+    if constexpr (SEARCH_STATS_ENABLED) {
+        for (const auto& l_context : m_contexts) {
+            m_stats.tableProbes += l_context->tableProbes;
+            m_stats.tableHits += l_context->tableHits;
+            m_stats.cutoffs += l_context->cutoffs;
+            m_stats.firstMoveCutoffs += l_context->firstMoveCutoffs;
+        }
+        for (const SearchStats::RootMove& l_rootMove : m_rootMoves) {
+            if (l_rootMove.move != 0) m_stats.rootMoves.push_back(l_rootMove);
+        }
     }
 
     return li_bestMove;  // Return the best move found
 }
 
+/**
+ * Looks the position up in the opening book. The book stores canonical positions, so the board is
+ * canonicalized first and the stored move is mapped back through the inverse of the transform.
+ * Only positions where the AI is the player to move are used, since the book move is for that player.
+ *
+ * @param a_board The current game board
+ * @return The book move (1 to SIZE), or 0 if there is no book for this board or the position is not in it
+ */
+template <typename TBoard>
+int AIPlayer<TBoard>::probeBook(const TBoard &a_board) const {
+    if (!m_book || !m_book->isFor(TBoard::ROWS, TBoard::COLS, TBoard::WIN_LENGTH)) {
+        return 0;
+    }
+    const int li_xCount = std::popcount(a_board.getMask(CellState::X));
+    const int li_oCount = std::popcount(a_board.getMask(CellState::O));
+    if ((li_xCount == li_oCount ? CellState::X : CellState::O) != m_player) {
+        return 0;
+    }
+
+    const auto l_canonical = a_board.canonicalize();
+    const OpeningBook::Entry* l_entry = m_book->find(l_canonical.board.getHash());
+    if (l_entry == nullptr || l_entry->move < 1 || l_entry->move > TBoard::SIZE) {
+        return 0;
+    }
+    const int li_move = TBoard::transformMove(l_entry->move, TBoard::INVERSE_SYMMETRIES[l_canonical.transform]);
+    return a_board.checkMove(li_move) ? li_move : 0;
+}
+
+/**
+ * Answers the position without searching, if it can be. On the 3x3 board the game is solved at compile time,
+ * so the move is read from SOLVED_3X3, and on 4x4 it is read from the tablebase when one was loaded.
+ * On every board a position found in the opening book is answered from the book.
+ *
+ * @param a_board The current game board
+ * @param ac_source Receives where the move came from, if one was found
+ * @return The move (position between 1 and SIZE), or 0 if the position has to be searched
+ */
+template <typename TBoard>
+int AIPlayer<TBoard>::lookupMove(const TBoard &a_board, SearchStats::Source &ac_source) const {
+    // The solved table holds the same move minimax would pick, as long as the AI is the player to move
+    if constexpr (std::is_same_v<TBoard, Board3x3>) {
+        if (sideToMove(a_board) == m_player) {
+            const SolvedEntry& l_entry = SOLVED_3X3[a_board.rank()];
+            if (l_entry.bestMove != 0) {
+                ac_source = SearchStats::Source::SOLVED_TABLE;
+                return l_entry.bestMove;
+            }
+        }
+    } else if constexpr (std::is_same_v<TBoard, Board4x4>) {
+        if (m_tablebase && m_tablebase->isReady()) {
+            if (const int li_move = m_tablebase->findBestMove(a_board, m_player); li_move != 0) {
+                ac_source = SearchStats::Source::TABLEBASE;
+                return li_move;
+            }
+        }
+    }
+    const int li_move = probeBook(a_board);
+    if (li_move != 0) {
+        ac_source = SearchStats::Source::BOOK;
+    }
+    return li_move;
+}
+
+/**
+ * Finds the best move for the AI using the minimax algorithm, unless lookupMove already knows it.
+ * A position pondering searched while the opponent was thinking is answered with the move found then.
+ * Either way getLastStats reports what the answer cost and where it came from.
+ *
+ * @param a_board The current game board
+ * @return The best move for the AI (position between 1 and SIZE)
+ */
+template <typename TBoard>
+int AIPlayer<TBoard>::findBestMove(TBoard &a_board) {
+    stopPondering();  // The opponent has moved, so the search threads are needed here
+    const auto l_start = std::chrono::steady_clock::now();
+    if (SearchStats::Source lc_source; const int li_move = lookupMove(a_board, lc_source)) {
+        m_stats = SearchStats{};
+        m_stats.source = lc_source;
+        m_stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_start);
+        return li_move;
+    }
+    const std::uint64_t lu_key = a_board.getHash();
+    const auto l_pondered = std::find_if(m_pondered.begin(), m_pondered.end(), [lu_key](const PonderedMove& a_entry) { return a_entry.key == lu_key; });
+    if (l_pondered != m_pondered.end() && a_board.checkMove(l_pondered->move)) {
+        m_stats = l_pondered->stats;
+        m_stats.source = SearchStats::Source::PONDERED;
+        m_lastValue = m_stats.value;
+        m_lastDepth = m_stats.depth;
+        return l_pondered->move;
+    }
+    return searchBestMove(a_board);
+}
+
+/**
+ * Starts pondering on a background thread. The replies pondered for the same position earlier, for instance
+ * before the opponent mistyped a move, are kept; those of any other position are dropped.
+ *
+ * @param a_board The current game board, with the opponent to move
+ */
+template <typename TBoard>
+void AIPlayer<TBoard>::startPondering(const TBoard &a_board) {
+    stopPondering();
+    if (a_board.checkWin(CellState::X) || a_board.checkWin(CellState::O) || a_board.checkDraw()) {
+        return;
+    }
+    if (a_board.getHash() != m_ponderKey) {
+        m_pondered.clear();
+        m_ponderKey = a_board.getHash();
+    }
+    m_ponderThread = std::thread(&AIPlayer::ponder, this, a_board);
+}
+
+/**
+ * Stops pondering and waits for the thread to finish. A reply whose search was cut short is not kept.
+ */
+template <typename TBoard>
+void AIPlayer<TBoard>::stopPondering() {
+    if (!m_ponderThread.joinable()) {
+        return;
+    }
+    m_ponderStopped.store(true, std::memory_order_relaxed);
+    m_ponderThread.join();
+    m_ponderStopped.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * Searches the position after each opponent reply with the normal move budget and keeps the answers.
+ * The reply the last search expected is tried first: it is the best move the transposition table holds
+ * for this position. The other replies follow in the static move order, skipping those that end the game,
+ * that lookupMove answers anyway, or that were already pondered. Whatever is not finished in time still
+ * leaves its results in the transposition table for the real search.
+ *
+ * @param a_board The position the opponent is to move in, copied for the pondering thread
+ */
+template <typename TBoard>
+void AIPlayer<TBoard>::ponder(TBoard a_board) {
+    std::array<std::uint8_t, TBoard::SIZE> l_replies;
+    int li_count = 0;
+    for (const std::uint8_t lu_move : MOVE_ORDER<TBoard>) {
+        if (a_board.checkMove(lu_move)) {
+            l_replies[li_count++] = lu_move;
+        }
+    }
+    if (TranspositionTable::Entry l_entry; m_table.probe(a_board.getHash(), l_entry) && l_entry.move != 0) {
+        std::stable_partition(l_replies.begin(), l_replies.begin() + li_count, [&l_entry](const int ai_move) { return ai_move == l_entry.move; });
+    }
+
+    const CellState lc_opponent = opponentOf(m_player);
+    for (int i = 0; i < li_count && !m_ponderStopped.load(std::memory_order_relaxed); i++) {
+        const bool lb_won = a_board.pushMove(lc_opponent, l_replies[i]);
+        const std::uint64_t lu_key = a_board.getHash();
+        const bool lb_known = std::any_of(m_pondered.begin(), m_pondered.end(), [lu_key](const PonderedMove& a_entry) { return a_entry.key == lu_key; });
+        if (SearchStats::Source lc_source; !lb_won && !lb_known && !a_board.checkDraw() && lookupMove(a_board, lc_source) == 0) {
+            const int li_move = searchBestMove(a_board);
+            if (!m_ponderStopped.load(std::memory_order_relaxed) && m_lastDepth > 0) {
+                m_pondered.push_back(PonderedMove{lu_key, li_move, m_stats});
+            }
+        }
+        a_board.popMove();
+    }
+}
+
 /**
  * Makes the best possible move for the AI on the board.
  * This method uses the minimax algorithm to find the best move and then applies it.
+ * With the logStats option the statistics of the search are printed first.
  *
  * @param a_board The board where the AI will make its move
  * @return true if the AI successfully made a move, false otherwise
  */
-bool AIPlayer::makeMove(Board &a_board) {
+template <typename TBoard>
+bool AIPlayer<TBoard>::makeMove(TBoard &a_board) {
     const int li_bestMove = findBestMove(a_board);  // Get the best move
+    if (m_logStats) {
+        m_stats.print();
+    }
 
     // Make the move at the best position found
-    a_board.makeMove(m_player, li_bestMove);
+    a_board.pushMove(m_player, li_bestMove);
     std::cout << "AI makes a move at position: " << li_bestMove << std::endl;
     return true;  // Return true to indicate the move was successful
 }
+
+/**
+ * Returns the number of positions visited during the last search, summed over all threads.
+ *
+ * @return The node count of the last search
+ */
+template <typename TBoard>
+std::uint64_t AIPlayer<TBoard>::getNodeCount() const {
+    std::uint64_t lu_nodes = 0;
+    for (const auto& l_context : m_contexts) {
+        lu_nodes += l_context->nodes;
+    }
+    return lu_nodes;
+}
+
+// Explicit instantiations for the board variants offered by the game
+template class AIPlayer<Board3x3>;
+template class AIPlayer<Board4x4>;
+template class AIPlayer<Board5x5>;
+template class AIPlayer<Board7x7>;
@@ -1,31 +1,154 @@
 #ifndef AIPLAYER_H
 #define AIPLAYER_H
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
 #include "Player.h"
 #include "Board.h"
+#include "SearchOptions.h"
+#include "SearchStats.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+
+class OpeningBook;
 
 // Class representing an AI player in the Tic-Tac-Toe game
-// Inherits from Player and uses the minimax algorithm to make optimal moves.
-class AIPlayer final : public Player {
+// Inherits from Player and uses the minimax algorithm with alpha-beta pruning to make optimal moves.
+// The search deepens one ply at a time until the game is solved or the time or node budget runs out,
+// so every move is answered within the budget on any board size.
+// With more than one thread the root moves of each iteration are shared out over a thread pool, or, in
+// Lazy SMP mode, every thread searches the whole position at a staggered depth and the threads only
+// share what they find through the lock-free transposition table.
+// While the opponent thinks, the AI can ponder: it searches the positions after the opponent's likely replies
+// on a background thread, so a reply it has already searched is answered at once.
+template <typename TBoard>
+class AIPlayer final : public Player<TBoard> {
+    using Player<TBoard>::m_player;
+
 public:
-    // Constructor initializes the AI player's symbol (usually 'O')
-    explicit AIPlayer(const CellState ac_player) : Player(ac_player) {}
+    // Constructor initializes the AI player's symbol (usually 'O'), its search budget, and its search threads
+    explicit AIPlayer(CellState ac_player, const SearchOptions& a_options = {});
+
+    // Destructor stops a search still pondering in the background
+    ~AIPlayer() override;
 
     // Override the makeMove method to allow the AI player to make a move
-    bool makeMove(Board &a_board) override;
+    bool makeMove(TBoard &a_board) override;
 
     // Override the getSymbol method to return the AI player's symbol (X or O)
     [[nodiscard]] CellState getSymbol() const override { return m_player; }
 
+    // Override the pondering functions to search the opponent's replies while they think
+    void startPondering(const TBoard &a_board) override;
+    void stopPondering() override;
+
+    // Function to find the best move for the AI using the minimax algorithm
+    int findBestMove(TBoard &a_board);
+
+    // Function to get the nodes visited by all threads during the last search
+    [[nodiscard]] std::uint64_t getNodeCount() const;
+
+    // Functions to get the score and depth of the last completed iteration of the last search
+    [[nodiscard]] int getLastValue() const { return m_lastValue; }
+    [[nodiscard]] int getLastDepth() const { return m_lastDepth; }
+
+    // Function to get the nodes, depth, timing, and table figures of the last findBestMove
+    [[nodiscard]] const SearchStats& getLastStats() const { return m_stats; }
+
 private:
+    // Killer moves and history scores pay off on the larger boards; on 3x3 the static order is already enough
+    static constexpr bool USE_MOVE_HEURISTICS = TBoard::SIZE > 9;
+
+    // Everything one search thread changes while it searches, so threads only share the transposition table
+    struct SearchContext {
+        TBoard board;                      // The thread's own copy of the position
+        std::uint64_t nodes = 0;           // Nodes visited by this thread in the current search
+        int depthLimit = 0;                // Ply at which the thread's current iteration evaluates heuristically
+        bool helper = false;               // Lazy SMP helper, whose results only reach the main thread through the table
+
+        // Per ply, the last two moves that caused a cutoff (0 for none)
+        std::array<std::array<std::uint8_t, 2>, TBoard::SIZE + 1> killers{};
+
+        // Per side (AI, opponent) and cell, how much the move has contributed to cutoffs
+        std::array<std::array<std::uint32_t, TBoard::SIZE>, 2> historyScores{};
+
+        // Counters for SearchStats, only updated when SEARCH_STATS_ENABLED
+        std::uint64_t tableProbes = 0;     // Transposition table lookups
+        std::uint64_t tableHits = 0;       // Lookups that found the position
+        std::uint64_t cutoffs = 0;         // Beta cutoffs
+        std::uint64_t firstMoveCutoffs = 0;  // Beta cutoffs by the first move tried
+    };
+
+    // The answer pondering found for the position after one opponent reply
+    struct PonderedMove {
+        std::uint64_t key;   // Hash of the position after the reply
+        int move;            // The move searchBestMove chose there
+        SearchStats stats;   // The statistics of that search, which also hold the move's score and depth
+    };
+
+    std::chrono::milliseconds m_moveTime;                 // Thinking time per move
+    std::uint64_t m_nodeLimit;                            // Nodes allowed per move
+    int m_maxDepth;                                       // Deepest iteration to search
+    bool m_lazySmp;                                       // Search with Lazy SMP instead of splitting the root moves
+    std::chrono::steady_clock::time_point m_deadline;     // When the current search has to stop
+    std::atomic<std::uint64_t> m_totalNodes{0};           // Nodes visited by all threads, counted in batches of 1024
+    std::atomic<bool> m_aborted{false};                   // Set when the budget interrupted an iteration
+    std::atomic<bool> m_helpersStopped{false};            // Set when the Lazy SMP main thread finished its iteration
+    int m_lastValue = 0;                                  // Score of the best move in the last completed iteration
+    int m_lastDepth = 0;                                  // Depth of the last completed iteration, 0 if none completed
+    bool m_logStats;                                      // Print the statistics of every move made through makeMove
+    SearchStats m_stats;                                  // Statistics of the last findBestMove
+    std::array<SearchStats::RootMove, TBoard::SIZE> m_rootMoves{};  // Cost of each root move in the current search, by move - 1
+
+    TranspositionTable m_table;                              // Results of positions already searched, shared by all threads
+    std::vector<std::unique_ptr<SearchContext>> m_contexts;  // One per search thread, indexed by worker
+    std::unique_ptr<ThreadPool> m_pool;                      // Threads for the root split, null when searching on one thread
+    std::shared_ptr<const Tablebase4x4> m_tablebase;         // Solved 4x4 positions, null if none were loaded
+    std::shared_ptr<const OpeningBook> m_book;               // Memory-mapped book positions, null if no book was opened
+
+    std::thread m_ponderThread;                              // Searches the opponent's replies while they think
+    std::atomic<bool> m_ponderStopped{false};                // Set to make the pondering thread give up
+    std::uint64_t m_ponderKey = 0;                           // Position the pondered replies were played in
+    std::vector<PonderedMove> m_pondered;                    // Answers found by pondering, for the positions after each reply
+
+    // Function to answer the position from the solved table, the tablebase, or the opening book, returns 0 if none has it
+    int lookupMove(const TBoard &a_board, SearchStats::Source &ac_source) const;
+
+    // Function run by the pondering thread: searches the position after each opponent reply, most likely first
+    void ponder(TBoard a_board);
+
+    // Function to look the position up in the opening book, returns 0 if it is not there
+    int probeBook(const TBoard &a_board) const;
+
     // Function to evaluate the current board state: win for AI, loss for player, or draw
-    int evaluateBoard(const Board &a_board) const;
+    int evaluateBoard(const TBoard &a_board) const;
 
-    // Recursive minimax algorithm function to explore possible moves
-    int minimax(Board &a_board, int ai_depth, bool ab_isMaximizingPlayer);
+    // Function to estimate an unfinished position from the win lines each player can still complete
+    int evaluateHeuristic(const TBoard &a_board) const;
 
-    // Function to find the best move for the AI using the minimax algorithm
-    int findBestMove(Board &a_board);
+    // Function to list the legal moves in the order they should be searched, returns how many there are
+    int orderMoves(const SearchContext &a_context, int ai_depth, bool ab_isMaximizingPlayer, int ai_firstMove,
+                   std::array<std::uint8_t, TBoard::SIZE> &a_moves) const;
+
+    // Function to remember a move that caused a cutoff, so it is tried early in sibling positions
+    void recordCutoff(SearchContext &a_context, int ai_depth, bool ab_isMaximizingPlayer, int ai_move);
+
+    // Function to count a batch of nodes and stop the search once the time or node budget is spent
+    void checkBudget();
+
+    // Function to check if a thread has to unwind: the budget is spent, or it is a helper whose iteration is over
+    [[nodiscard]] bool isStopped(const SearchContext &a_context) const;
+
+    // Recursive minimax algorithm with alpha-beta pruning to explore possible moves on a thread's board
+    int minimax(SearchContext &a_context, int ai_depth, bool ab_isMaximizingPlayer, int ai_alpha, int ai_beta);
+
+    // Function to search the root moves with iterative deepening, without consulting the solved table
+    int searchBestMove(TBoard &a_board);
 };
 
-#endif // AIPLAYER_H
\ No newline at end of file
+#endif // AIPLAYER_H
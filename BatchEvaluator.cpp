@@ -0,0 +1,208 @@
+#include "BatchEvaluator.h"
+#if defined(__AVX2__) || (defined(__AVX512F__) && defined(__AVX512BW__))
+#include <immintrin.h>
+#endif
+
+namespace {
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+constexpr bool USE_AVX512 = true;
+constexpr bool USE_AVX2 = false;
+#elif defined(__AVX2__)
+constexpr bool USE_AVX512 = false;
+constexpr bool USE_AVX2 = true;
+#else
+constexpr bool USE_AVX512 = false;
+constexpr bool USE_AVX2 = false;
+#endif
+
+// Status of one position, the scalar way: used without SIMD and for the positions left over after the last full register
+template <typename TBoard>
+std::uint8_t statusOf(const typename TBoard::Mask au_x, const typename TBoard::Mask au_o) {
+    const bool lb_xWins = TBoard::hasWinningLine(au_x);
+    const bool lb_oWins = TBoard::hasWinningLine(au_o);
+    const bool lb_full = (au_x | au_o) == TBoard::FULL_MASK;
+    return static_cast<std::uint8_t>((lb_xWins ? BatchEvaluator<TBoard>::X_WINS : 0) | (lb_oWins ? BatchEvaluator<TBoard>::O_WINS : 0) |
+                                     (lb_full && !lb_xWins && !lb_oWins ? BatchEvaluator<TBoard>::DRAW : 0));
+}
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+// The AVX-512 operations for each mask width: compares give one bit per board, and the status lanes are
+// narrowed to bytes as they are stored
+template <typename TMask>
+struct Avx512Lanes;
+
+template <>
+struct Avx512Lanes<std::uint16_t> {
+    using Bits = __mmask32;
+    static __m512i broadcast(const std::uint16_t au_value) { return _mm512_set1_epi16(static_cast<short>(au_value)); }
+    static Bits equal(const __m512i a_left, const __m512i a_right) { return _mm512_cmpeq_epi16_mask(a_left, a_right); }
+    static __m512i select(const Bits au_bits, const std::uint8_t au_value) { return _mm512_maskz_set1_epi16(au_bits, au_value); }
+    static void store(std::uint8_t* a_out, const __m512i a_lanes) { _mm512_mask_cvtepi16_storeu_epi8(a_out, static_cast<Bits>(~Bits{0}), a_lanes); }
+};
+
+template <>
+struct Avx512Lanes<std::uint32_t> {
+    using Bits = __mmask16;
+    static __m512i broadcast(const std::uint32_t au_value) { return _mm512_set1_epi32(static_cast<int>(au_value)); }
+    static Bits equal(const __m512i a_left, const __m512i a_right) { return _mm512_cmpeq_epi32_mask(a_left, a_right); }
+    static __m512i select(const Bits au_bits, const std::uint8_t au_value) { return _mm512_maskz_set1_epi32(au_bits, au_value); }
+    static void store(std::uint8_t* a_out, const __m512i a_lanes) { _mm512_mask_cvtepi32_storeu_epi8(a_out, static_cast<Bits>(~Bits{0}), a_lanes); }
+};
+
+template <>
+struct Avx512Lanes<std::uint64_t> {
+    using Bits = __mmask8;
+    static __m512i broadcast(const std::uint64_t au_value) { return _mm512_set1_epi64(static_cast<long long>(au_value)); }
+    static Bits equal(const __m512i a_left, const __m512i a_right) { return _mm512_cmpeq_epi64_mask(a_left, a_right); }
+    static __m512i select(const Bits au_bits, const std::uint8_t au_value) { return _mm512_maskz_set1_epi64(au_bits, au_value); }
+    static void store(std::uint8_t* a_out, const __m512i a_lanes) { _mm512_mask_cvtepi64_storeu_epi8(a_out, static_cast<Bits>(~Bits{0}), a_lanes); }
+};
+
+/**
+ * Evaluates the positions one 512-bit register at a time. Every win line is broadcast and compared with the
+ * masks of all boards in the register at once; the compare results are bit masks, one bit per board.
+ *
+ * @return The number of positions evaluated, a multiple of the register's board count
+ */
+template <typename TBoard>
+std::size_t evaluateWide(const typename TBoard::Mask* a_x, const typename TBoard::Mask* a_o, const std::size_t au_count, std::uint8_t* a_status) {
+    using Mask = typename TBoard::Mask;
+    using Lanes = Avx512Lanes<Mask>;
+    constexpr std::size_t BOARDS = sizeof(__m512i) / sizeof(Mask);
+    const __m512i l_full = Lanes::broadcast(TBoard::FULL_MASK);
+
+    std::size_t i = 0;
+    for (; i + BOARDS <= au_count; i += BOARDS) {
+        const __m512i l_x = _mm512_loadu_si512(a_x + i);
+        const __m512i l_o = _mm512_loadu_si512(a_o + i);
+        typename Lanes::Bits lu_xWins = 0, lu_oWins = 0;
+        for (const Mask lu_line : TBoard::WIN_MASKS) {
+            const __m512i l_line = Lanes::broadcast(lu_line);
+            lu_xWins |= Lanes::equal(_mm512_and_si512(l_x, l_line), l_line);
+            lu_oWins |= Lanes::equal(_mm512_and_si512(l_o, l_line), l_line);
+        }
+        const auto lu_draws = static_cast<typename Lanes::Bits>(Lanes::equal(_mm512_or_si512(l_x, l_o), l_full) & ~(lu_xWins | lu_oWins));
+        const __m512i l_status = _mm512_or_si512(_mm512_or_si512(Lanes::select(lu_xWins, BatchEvaluator<TBoard>::X_WINS),
+                                                                 Lanes::select(lu_oWins, BatchEvaluator<TBoard>::O_WINS)),
+                                                 Lanes::select(lu_draws, BatchEvaluator<TBoard>::DRAW));
+        Lanes::store(a_status + i, l_status);
+    }
+    return i;
+}
+#elif defined(__AVX2__)
+// The AVX2 operations for each mask width: compares give all-ones lanes for the boards that match
+template <typename TMask>
+struct Avx2Lanes;
+
+template <>
+struct Avx2Lanes<std::uint16_t> {
+    static __m256i broadcast(const std::uint16_t au_value) { return _mm256_set1_epi16(static_cast<short>(au_value)); }
+    static __m256i equal(const __m256i a_left, const __m256i a_right) { return _mm256_cmpeq_epi16(a_left, a_right); }
+};
+
+template <>
+struct Avx2Lanes<std::uint32_t> {
+    static __m256i broadcast(const std::uint32_t au_value) { return _mm256_set1_epi32(static_cast<int>(au_value)); }
+    static __m256i equal(const __m256i a_left, const __m256i a_right) { return _mm256_cmpeq_epi32(a_left, a_right); }
+};
+
+template <>
+struct Avx2Lanes<std::uint64_t> {
+    static __m256i broadcast(const std::uint64_t au_value) { return _mm256_set1_epi64x(static_cast<long long>(au_value)); }
+    static __m256i equal(const __m256i a_left, const __m256i a_right) { return _mm256_cmpeq_epi64(a_left, a_right); }
+};
+
+/**
+ * Evaluates the positions one 256-bit register at a time. Every win line is broadcast and compared with the
+ * masks of all boards in the register at once. The status is built in lanes as wide as the masks and
+ * narrowed to bytes through a small buffer, since AVX2 has no narrowing store.
+ *
+ * @return The number of positions evaluated, a multiple of the register's board count
+ */
+template <typename TBoard>
+std::size_t evaluateWide(const typename TBoard::Mask* a_x, const typename TBoard::Mask* a_o, const std::size_t au_count, std::uint8_t* a_status) {
+    using Mask = typename TBoard::Mask;
+    using Lanes = Avx2Lanes<Mask>;
+    constexpr std::size_t BOARDS = sizeof(__m256i) / sizeof(Mask);
+    const __m256i l_full = Lanes::broadcast(TBoard::FULL_MASK);
+    const __m256i l_xBit = Lanes::broadcast(BatchEvaluator<TBoard>::X_WINS);
+    const __m256i l_oBit = Lanes::broadcast(BatchEvaluator<TBoard>::O_WINS);
+    const __m256i l_drawBit = Lanes::broadcast(BatchEvaluator<TBoard>::DRAW);
+
+    std::size_t i = 0;
+    for (; i + BOARDS <= au_count; i += BOARDS) {
+        const __m256i l_x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_x + i));
+        const __m256i l_o = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a_o + i));
+        __m256i l_xWins = _mm256_setzero_si256(), l_oWins = _mm256_setzero_si256();
+        for (const Mask lu_line : TBoard::WIN_MASKS) {
+            const __m256i l_line = Lanes::broadcast(lu_line);
+            l_xWins = _mm256_or_si256(l_xWins, Lanes::equal(_mm256_and_si256(l_x, l_line), l_line));
+            l_oWins = _mm256_or_si256(l_oWins, Lanes::equal(_mm256_and_si256(l_o, l_line), l_line));
+        }
+        const __m256i l_draws = _mm256_andnot_si256(_mm256_or_si256(l_xWins, l_oWins), Lanes::equal(_mm256_or_si256(l_x, l_o), l_full));
+        const __m256i l_status = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(l_xWins, l_xBit), _mm256_and_si256(l_oWins, l_oBit)),
+                                                 _mm256_and_si256(l_draws, l_drawBit));
+        alignas(32) Mask l_lanes[BOARDS];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(l_lanes), l_status);
+        for (std::size_t j = 0; j < BOARDS; ++j) {
+            a_status[i + j] = static_cast<std::uint8_t>(l_lanes[j]);
+        }
+    }
+    return i;
+}
+#else
+// Without SIMD every position goes through the scalar loop
+template <typename TBoard>
+std::size_t evaluateWide(const typename TBoard::Mask*, const typename TBoard::Mask*, std::size_t, std::uint8_t*) {
+    return 0;
+}
+#endif
+
+} // namespace
+
+/**
+ * Computes the status of many positions: which players have a complete line, and whether the board is full
+ * without one. As many positions as fit are evaluated a vector register at a time, the rest one by one.
+ * A position may have lines for both players; it is up to the caller whether such a position can occur.
+ *
+ * @param a_x X's cells of every position
+ * @param a_o O's cells of every position
+ * @param au_count The number of positions
+ * @param a_status Receives the status bits of every position
+ */
+template <typename TBoard>
+void BatchEvaluator<TBoard>::evaluate(const Mask* a_x, const Mask* a_o, const std::size_t au_count, std::uint8_t* a_status) {
+    for (std::size_t i = evaluateWide<TBoard>(a_x, a_o, au_count, a_status); i < au_count; ++i) {
+        a_status[i] = statusOf<TBoard>(a_x[i], a_o[i]);
+    }
+}
+
+/**
+ * Computes the status of every position in a batch.
+ *
+ * @param a_batch The positions
+ * @param a_status Receives the status bits, one per position in the order they were added
+ */
+template <typename TBoard>
+void BatchEvaluator<TBoard>::evaluate(const Batch& a_batch, std::vector<std::uint8_t>& a_status) {
+    a_status.resize(a_batch.size());
+    evaluate(a_batch.x.data(), a_batch.o.data(), a_batch.size(), a_status.data());
+}
+
+/**
+ * Names the instruction set the batch evaluation was compiled for.
+ *
+ * @return "AVX-512", "AVX2", or "scalar"
+ */
+template <typename TBoard>
+const char* BatchEvaluator<TBoard>::getInstructionSet() {
+    return USE_AVX512 ? "AVX-512" : USE_AVX2 ? "AVX2" : "scalar";
+}
+
+// Explicit instantiations for the k-in-a-row boards
+template class BatchEvaluator<Board3x3>;
+template class BatchEvaluator<Board4x4>;
+template class BatchEvaluator<Board5x5>;
+template class BatchEvaluator<Board6x6>;
+template class BatchEvaluator<Board7x7>;
@@ -0,0 +1,47 @@
+#ifndef BATCHEVALUATOR_H
+#define BATCHEVALUATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Board.h"
+
+// Win, draw, and terminal status of many independent positions at once, for work that handles positions by the
+// million as raw cell masks: tablebase construction, solvers, and stepping many self-play games side by side.
+// The positions are given in structure-of-arrays layout, all X masks in one array and all O masks in another,
+// so one vector register holds the masks of many boards: with AVX-512, 32 boards of up to 16 cells, 16 of up
+// to 32 cells, or 8 of up to 64 cells are tested against a win line per instruction, and half as many with AVX2.
+// The instruction set is chosen when the library is compiled (cmake -DTICTACTOE_NATIVE=ON builds for the host
+// CPU); without AVX2 the same results come from a scalar loop.
+// A Board tracks its own completed lines as moves are made, so a single game is still best asked directly.
+template <typename TBoard>
+class BatchEvaluator {
+public:
+    using Mask = typename TBoard::Mask;
+
+    // Status bits of one position; 0 means the game goes on, anything else that it is over
+    static constexpr std::uint8_t X_WINS = 1;  // X has a complete line
+    static constexpr std::uint8_t O_WINS = 2;  // O has a complete line
+    static constexpr std::uint8_t DRAW = 4;    // Every cell is filled and neither player has a line
+
+    // Positions in structure-of-arrays layout, ready to be evaluated
+    struct Batch {
+        std::vector<Mask> x;  // X's cells of every position
+        std::vector<Mask> o;  // O's cells of every position
+
+        void add(const TBoard& a_board) { add(a_board.getMask(CellState::X), a_board.getMask(CellState::O)); }  // Append a board
+        void add(const Mask au_x, const Mask au_o) { x.push_back(au_x); o.push_back(au_o); }                    // Append a position
+        void clear() { x.clear(); o.clear(); }                                                                  // Remove every position
+        [[nodiscard]] std::size_t size() const { return x.size(); }                                              // Get the number of positions
+    };
+
+    // Functions
+    // Compute the status of au_count positions, a_x[i] and a_o[i] being the cells of position i, into a_status[i]
+    static void evaluate(const Mask* a_x, const Mask* a_o, std::size_t au_count, std::uint8_t* a_status);
+    // Compute the status of every position in a batch, resizing a_status to match
+    static void evaluate(const Batch& a_batch, std::vector<std::uint8_t>& a_status);
+    // Get the name of the instruction set evaluate was compiled for: "AVX-512", "AVX2", or "scalar"
+    [[nodiscard]] static const char* getInstructionSet();
+};
+
+#endif // BATCHEVALUATOR_H
@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <initializer_list>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "AIPlayer.h"
+#include "BatchEvaluator.h"
+#include "MCTSPlayer.h"
+#include "SparseBoard.h"
+#include "UltimateBoard.h"
+
+// Measures how the parallel search scales with the number of threads.
+// Every run searches the same position to a fixed depth, so the time to depth is comparable between
+// thread counts; a bigger speedup means the extra threads did useful work rather than duplicated it.
+// The MCTS player is measured by its playout rate over a fixed time instead, since it has no depth.
+// Last, many random self-play games are stepped side by side to measure the batch evaluation of BatchEvaluator.
+// Usage: TicTacToe_bench [max threads], with thread counts doubling from 1 up to the maximum (default 64).
+
+// One benchmark position: moves alternate X, O, X, ... and the AI plays the side to move next
+struct BenchPosition {
+    const char* name;
+    int depth;
+    std::initializer_list<int> moves;
+};
+
+// Searches a position once per thread count in both parallel modes and prints one line per run
+template <typename TBoard>
+void benchPosition(const BenchPosition& a_position, const int ai_maxThreads) {
+    TBoard l_board;
+    CellState lc_player = CellState::X;
+    for (const int li_move : a_position.moves) {
+        l_board.pushMove(lc_player, li_move);
+        lc_player = opponentOf(lc_player);
+    }
+
+    for (const bool lb_lazySmp : {false, true}) {
+        double lf_baseMilliseconds = 0;
+        for (int li_threads = 1; li_threads <= ai_maxThreads; li_threads *= 2) {
+            SearchOptions l_options;
+            l_options.moveTime = std::chrono::hours(1);  // Only the depth ends the search
+            l_options.maxDepth = a_position.depth;
+            l_options.threads = li_threads;
+            l_options.lazySmp = lb_lazySmp;
+            AIPlayer<TBoard> l_player(lc_player, l_options);
+
+            const auto l_start = std::chrono::steady_clock::now();
+            const int li_move = l_player.findBestMove(l_board);
+            const double lf_milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - l_start).count();
+            if (li_threads == 1) lf_baseMilliseconds = lf_milliseconds;
+
+            std::cout << std::left << std::setw(12) << a_position.name << std::setw(11) << (lb_lazySmp ? "lazy-smp" : "root-split")
+                      << std::right << std::setw(8) << li_threads << std::setw(6) << li_move
+                      << std::setw(12) << std::fixed << std::setprecision(1) << lf_milliseconds
+                      << std::setw(14) << l_player.getNodeCount()
+                      << std::setw(12) << std::setprecision(0) << l_player.getNodeCount() / std::max(lf_milliseconds, 0.001)
+                      << std::setw(9) << std::setprecision(2) << lf_baseMilliseconds / std::max(lf_milliseconds, 0.001) << "\n";
+        }
+    }
+}
+
+// Runs the MCTS player for half a second per thread count and prints its playout rate
+template <typename TBoard>
+void benchPlayouts(const char* as_name, const TBoard& a_board, const int ai_maxThreads) {
+    for (int li_threads = 1; li_threads <= ai_maxThreads; li_threads *= 2) {
+        SearchOptions l_options;
+        l_options.moveTime = std::chrono::milliseconds(500);
+        l_options.threads = li_threads;
+        MCTSPlayer<TBoard> l_player(a_board.getSideToMove(), l_options);
+
+        const auto l_start = std::chrono::steady_clock::now();
+        l_player.findBestMove(a_board);
+        const double lf_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - l_start).count();
+        const double lf_rate = l_player.getPlayoutCount() / lf_seconds;
+        std::cout << std::left << std::setw(12) << as_name << std::right << std::setw(8) << li_threads
+                  << std::setw(12) << l_player.getPlayoutCount() << std::setw(14) << std::fixed << std::setprecision(0) << lf_rate
+                  << std::setw(14) << lf_rate / li_threads << "\n";
+    }
+}
+
+// Plays ai_games random games in lockstep: every ply adds one random move to each unfinished game, then one
+// BatchEvaluator call finds the games that just ended. Prints the positions evaluated per second.
+template <typename TBoard>
+void benchSelfPlay(const char* as_name, const int ai_games) {
+    using Mask = typename TBoard::Mask;
+    typename BatchEvaluator<TBoard>::Batch l_games;
+    for (int i = 0; i < ai_games; ++i) {
+        l_games.add(0, 0);
+    }
+    std::vector<std::uint8_t> l_status(l_games.size(), 0);
+    std::mt19937_64 l_random(1);
+    std::uint64_t lu_positions = 0;
+    double lf_seconds = 0;
+
+    for (int ply = 0; ply < TBoard::SIZE; ++ply) {
+        std::vector<Mask>& l_movers = ply % 2 == 0 ? l_games.x : l_games.o;
+        for (std::size_t i = 0; i < l_games.size(); ++i) {
+            if (l_status[i] != 0) continue;
+            Mask lu_empty = static_cast<Mask>(TBoard::FULL_MASK & ~(l_games.x[i] | l_games.o[i]));
+            for (int skip = static_cast<int>(l_random() % std::popcount(lu_empty)); skip > 0; --skip) {
+                lu_empty = static_cast<Mask>(lu_empty & (lu_empty - 1));
+            }
+            l_movers[i] |= static_cast<Mask>(lu_empty & (~lu_empty + 1));  // The lowest remaining empty cell
+        }
+        const auto l_start = std::chrono::steady_clock::now();
+        BatchEvaluator<TBoard>::evaluate(l_games, l_status);
+        lf_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - l_start).count();
+        lu_positions += l_games.size();
+    }
+    std::cout << std::left << std::setw(12) << as_name << std::right << std::setw(10) << BatchEvaluator<TBoard>::getInstructionSet()
+              << std::setw(10) << ai_games << std::setw(16) << std::fixed << std::setprecision(0) << lu_positions / lf_seconds << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    const int li_maxThreads = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 64;
+    std::cout << "Hardware threads: " << std::thread::hardware_concurrency() << "\n";
+    std::cout << "position    mode        threads  move     time ms         nodes  nodes/ms  speedup\n";
+
+    benchPosition<Board5x5>(BenchPosition{"5x5 open", 8, {13, 7}}, li_maxThreads);
+    benchPosition<Board5x5>(BenchPosition{"5x5 middle", 10, {13, 7, 8, 18, 12, 14}}, li_maxThreads);
+    benchPosition<Board7x7>(BenchPosition{"7x7 open", 6, {25, 17}}, li_maxThreads);
+
+    std::cout << "\nposition     threads    playouts    playouts/s    per thread\n";
+    benchPlayouts("ultimate", UltimateBoard{}, li_maxThreads);
+    SparseBoard l_gomoku(5, 15);
+    l_gomoku.pushMove(CellState::X, SparseBoard::encodeMove(7, 7));
+    benchPlayouts("gomoku 15x15", l_gomoku, li_maxThreads);
+
+    std::cout << "\nself-play          isa     games     positions/s\n";
+    benchSelfPlay<Board5x5>("5x5", 100000);
+    benchSelfPlay<Board7x7>("7x7", 100000);
+    return 0;
+}
@@ -1,34 +1,38 @@
 #include "Board.h"
-#include <algorithm>
+#include <iomanip>
 #include <iostream>
-
-// Constructor that initializes the board with all cells set to EMPTY
-Board::Board() {
-    m_board.fill(CellState::EMPTY);         // Initialize the board with all cells set to EMPTY
-}
+#include <string>
 
 /**
  * Prints the current state of the board.
- * The board is printed in a 3x3 grid, with each cell showing either a number (if empty),
+ * The board is printed as a Rows x Cols grid, with each cell showing either a number (if empty),
  * 'X' (if occupied by player X), or 'O' (if occupied by player O).
  */
-void Board::printBoard() const {
+template <int Rows, int Cols, int K>
+void Board<Rows, Cols, K>::printBoard() const {
+    const int li_width = SIZE < 10 ? 1 : 2;  // Width of the widest cell number, so columns stay aligned
+
+    // Separator between rows, e.g. "---+---+---" on the 3x3 board
+    std::string ls_separator;
+    for (int col = 0; col < Cols; ++col) {
+        ls_separator += std::string(li_width + 2, '-') + (col + 1 < Cols ? "+" : "\n");
+    }
+
     for (int i = 0; i < SIZE; i++) {
-        if (m_board[i] == CellState::EMPTY) {
-            std::cout << " " << (i + 1) << " ";  // Print the number if the cell is empty (for user input)
-        } else if (m_board[i] == CellState::X) {
-            std::cout << " X ";                  // Print X if the cell is occupied by player X
-        } else if (m_board[i] == CellState::O) {
-            std::cout << " O ";                  // Print O if the cell is occupied by player O
+        const CellState lc_cell = cellAt(i);
+        if (lc_cell == CellState::EMPTY) {
+            std::cout << " " << std::setw(li_width) << (i + 1) << " ";  // Print the number if the cell is empty (for user input)
+        } else {
+            std::cout << " " << std::setw(li_width) << lc_cell << " ";  // Print X or O if the cell is occupied
         }
 
         // Print the separator between cells, unless it's the last cell in a row
-        if ((i + 1) % 3 != 0) {
+        if ((i + 1) % Cols != 0) {
             std::cout << "|";                   // Vertical separator between cells
         } else {
             std::cout << std::endl;             // Newline at the end of each row
-            if (i != 8) {
-                std::cout << "---+---+---\n";   // Separator between rows (not after the last row)
+            if (i != SIZE - 1) {
+                std::cout << ls_separator;      // Separator between rows (not after the last row)
             }
         }
     }
@@ -38,11 +42,12 @@ void Board::printBoard() const {
  * Prints all available (empty) cells on the board with their corresponding cell numbers.
  * This helps the player know where they can make a move.
  */
-void Board::printAvailableMoves() const {
+template <int Rows, int Cols, int K>
+void Board<Rows, Cols, K>::printAvailableMoves() const {
     std::cout << "Available moves: ";
     for (int i = 0; i < SIZE; ++i) {
         // Print the number of the cell if it is empty (i.e., a valid move)
-        if (m_board[i] == CellState::EMPTY) {
+        if (checkMove(i + 1)) {
             std::cout << "(" << (i + 1) << ") ";  // Print the move number (i + 1 to match human-readable indexing)
         }
     }
@@ -50,80 +55,52 @@ void Board::printAvailableMoves() const {
 }
 
 /**
- * Checks if a player has won the game.
- * A player wins if they have three of their marks (X or O) in a row, column, or diagonal.
+ * Returns a copy of the position with one of the board symmetries applied.
+ * The copy is rebuilt through makeMove, so its line counters and hash are consistent.
  *
- * @param ac_player The player to check (either X or O)
- * @return true if the player has won, false otherwise
+ * @param ai_transform The symmetry index (0 to SYMMETRY_COUNT - 1)
+ * @return The transformed position
  */
-bool Board::checkWin(const CellState ac_player) const {
-    // Define all possible win patterns (rows, columns, and diagonals)
-    static constexpr int winPatterns[8][3] = {
-        {0, 1, 2},      // Top row
-        {3, 4, 5},      // Middle row
-        {6, 7, 8},      // Bottom row
-        {0, 4, 8},      // Main diagonal
-        {6, 4, 2},      // Anti-diagonal
-        {0, 3, 6},      // Left column
-        {1, 4, 7},      // Middle column
-        {2, 5, 8}       // Right column
-    };
-
-    // Check if the player has three of their marks in any winning combination
-    for (const auto& pattern : winPatterns) {
-        if (m_board[pattern[0]] == ac_player &&
-            m_board[pattern[1]] == ac_player &&
-            m_board[pattern[2]] == ac_player) {
-            return true;    // A win is found
+template <int Rows, int Cols, int K>
+Board<Rows, Cols, K> Board<Rows, Cols, K>::transformed(const int ai_transform) const {
+    Board l_result;
+    for (int i = 0; i < SIZE; ++i) {
+        const CellState lc_cell = cellAt(i);
+        if (lc_cell != CellState::EMPTY) {
+            l_result.makeMove(lc_cell, SYMMETRIES[ai_transform][i] + 1);
         }
     }
-    return false;           // No win found
-}
-
-/**
- * Checks if the game is a draw.
- * A draw occurs if all cells are filled and no player has won.
- *
- * @return true if the game is a draw, false otherwise
- */
-bool Board::checkDraw() const {
-    // Check if all cells are filled (no empty cells left)
-    return std::ranges::none_of(m_board, [](const CellState& cell) {
-        return cell == CellState::EMPTY;  // If there's any empty cell, it's not a draw
-    });
+    return l_result;
 }
 
 /**
- * Checks if a move is valid.
- * A move is valid if the corresponding cell is empty.
+ * Maps the position to its canonical form: the orientation whose (X mask, O mask) pair is smallest.
+ * All rotations and reflections of a position share the same canonical form, so it can be used as a cache key.
  *
- * @param ai_move The move number (1-9) to check
- * @return true if the move is valid (the cell is empty), false otherwise
+ * @return The canonical position and the transform that maps the current position onto it
  */
-bool Board::checkMove(const int ai_move) const {
-    // Check if the move is valid by checking if the chosen cell is empty
-    return m_board[ai_move - 1] == CellState::EMPTY;  // Convert 1-based move to 0-based index
-}
+template <int Rows, int Cols, int K>
+typename Board<Rows, Cols, K>::Canonical Board<Rows, Cols, K>::canonicalize() const {
+    int li_best = 0;
+    Mask lu_bestX = m_xMask;
+    Mask lu_bestO = m_oMask;
 
-/**
- * Makes a move for a player by placing their symbol (X or O) in the specified cell.
- *
- * @param ac_player The player making the move (either X or O)
- * @param ai_move The move number (1-9) indicating where to place the player's symbol
- */
-void Board::makeMove(const CellState ac_player, const int ai_move) {
-    // Place the player's move in the specified position on the board
-    m_board[ai_move - 1] = ac_player;  // Convert 1-based move to 0-based index
+    // Compare the masks of every symmetry first and only build the winning board once
+    for (int t = 1; t < SYMMETRY_COUNT; ++t) {
+        const Mask lu_x = transformMask(m_xMask, t);
+        const Mask lu_o = transformMask(m_oMask, t);
+        if (lu_x < lu_bestX || (lu_x == lu_bestX && lu_o < lu_bestO)) {
+            li_best = t;
+            lu_bestX = lu_x;
+            lu_bestO = lu_o;
+        }
+    }
+    return Canonical{transformed(li_best), li_best};
 }
 
-/**
- * Returns the symbol at a specific position on the board.
- * The position is specified by the row and column indices (0-based).
- *
- * @param ai_row The row index (0, 1, or 2)
- * @param a_col The column index (0, 1, or 2)
- * @return The symbol (X, O, or EMPTY) at the specified position
- */
-CellState Board::getSymbol(const int ai_row, const int a_col) const {
-    return m_board[ai_row * 3 + a_col];  // Convert row and column to 1D index
-}
\ No newline at end of file
+// Explicit instantiations for the board variants offered by the game
+template class Board<3, 3, 3>;
+template class Board<4, 4, 4>;
+template class Board<5, 5, 4>;
+template class Board<6, 6, 5>;
+template class Board<7, 7, 5>;
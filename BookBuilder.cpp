@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "AIPlayer.h"
+#include "OpeningBook.h"
+
+// Builds an opening book file for the game's --book option.
+// Every position reachable within the given number of plies is reduced to its canonical form, so each
+// rotation or reflection is searched once, and searched with the normal AI for the player to move.
+// The 3x3 board is solved at compile time and needs no book.
+// Usage: TicTacToe_book <4x4|5x5|7x7> <plies> <file> [move time ms] [threads]
+
+// Lists the canonical positions with at most ai_plies marks that are still in play
+template <typename TBoard>
+std::vector<TBoard> collectPositions(const int ai_plies) {
+    std::vector<TBoard> l_positions;
+    std::unordered_set<std::uint64_t> l_seen;
+    std::vector<TBoard> l_layer{TBoard{}};
+    l_seen.insert(TBoard{}.getHash());
+
+    for (int ply = 0; ply <= ai_plies && !l_layer.empty(); ++ply) {
+        std::vector<TBoard> l_next;
+        const CellState lc_player = ply % 2 == 0 ? CellState::X : CellState::O;
+        for (const TBoard& l_board : l_layer) {
+            if (l_board.checkWin(CellState::X) || l_board.checkWin(CellState::O) || l_board.checkDraw()) {
+                continue;  // Nothing to choose in a finished game
+            }
+            l_positions.push_back(l_board);
+            if (ply == ai_plies) {
+                continue;
+            }
+            for (int i = 1; i <= TBoard::SIZE; ++i) {
+                if (!l_board.checkMove(i)) {
+                    continue;
+                }
+                TBoard l_child = l_board;
+                l_child.pushMove(lc_player, i);
+                const auto l_canonical = l_child.canonicalize();
+                if (l_seen.insert(l_canonical.board.getHash()).second) {
+                    l_next.push_back(l_canonical.board);
+                }
+            }
+        }
+        l_layer = std::move(l_next);
+    }
+    return l_positions;
+}
+
+// Searches every collected position and writes the book, returns the process exit code
+template <typename TBoard>
+int buildBook(const int ai_plies, const std::string& as_path, const SearchOptions& a_options) {
+    const std::vector<TBoard> l_positions = collectPositions<TBoard>(ai_plies);
+    std::cout << "Searching " << l_positions.size() << " positions...\n";
+
+    std::vector<OpeningBook::Entry> l_entries;
+    for (const TBoard& l_position : l_positions) {
+        TBoard l_board = l_position;
+        const int li_marks = TBoard::SIZE - std::popcount(l_board.getMask(CellState::EMPTY));
+        AIPlayer<TBoard> l_player(li_marks % 2 == 0 ? CellState::X : CellState::O, a_options);
+        const int li_move = l_player.findBestMove(l_board);
+        if (l_player.getLastDepth() == 0) {
+            continue;  // Not even the first iteration finished, so the move is only a guess
+        }
+        l_entries.push_back(OpeningBook::Entry{l_board.getHash(), l_player.getLastValue(), static_cast<std::uint8_t>(li_move),
+                                               static_cast<std::uint8_t>(l_player.getLastDepth()), 0});
+    }
+
+    if (!OpeningBook::write(as_path, TBoard::ROWS, TBoard::COLS, TBoard::WIN_LENGTH, std::move(l_entries))) {
+        std::cerr << "Could not write the book to " << as_path << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << as_path << "\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        std::cerr << "Usage: TicTacToe_book <4x4|5x5|7x7> <plies> <file> [move time ms] [threads]\n";
+        return 1;
+    }
+    const std::string ls_variant = argv[1];
+    const int li_plies = std::max(std::atoi(argv[2]), 0);
+    SearchOptions l_options;
+    if (argc > 4) l_options.moveTime = std::chrono::milliseconds(std::max(std::atoll(argv[4]), 1LL));
+    if (argc > 5) l_options.threads = std::max(std::atoi(argv[5]), 1);
+
+    if (ls_variant == "4x4") return buildBook<Board4x4>(li_plies, argv[3], l_options);
+    if (ls_variant == "5x5") return buildBook<Board5x5>(li_plies, argv[3], l_options);
+    if (ls_variant == "7x7") return buildBook<Board7x7>(li_plies, argv[3], l_options);
+    std::cerr << "Unknown board variant: " << ls_variant << "\n";
+    return 1;
+}
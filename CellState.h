@@ -27,6 +27,18 @@ enum class CellState {
     }
 }
 
+// Returns the symbol of the opposing player (X <-> O). EMPTY has no opponent and maps to itself.
+[[nodiscard]] constexpr CellState opponentOf(const CellState ac_player) {
+    switch (ac_player) {
+        case CellState::X:
+            return CellState::O;
+        case CellState::O:
+            return CellState::X;
+        default:
+            return CellState::EMPTY;
+    }
+}
+
 // Overload the output stream operator (<<) for the CellState type.
 // This allows easy printing of CellState objects using std::cout, such as when printing the board.
 inline std::ostream& operator<<(std::ostream& os, const CellState& ac_Cell) {
@@ -3,31 +3,43 @@
 #include <iostream>
 #include "AIPlayer.h"
 #include "HumanPlayer.h"
+#include "MCTSPlayer.h"
+#include "QubicAIPlayer.h"
+#include "UltimateAIPlayer.h"
 
 // Constructor that initializes the game with a specified game mode.
-Game::Game(const GameMode am_mode) : m_gameMode(am_mode) {
+template <typename TBoard, typename TAIPlayer>
+Game<TBoard, TAIPlayer>::Game(const GameMode am_mode, const SearchOptions& a_options) : m_gameMode(am_mode), m_options(a_options) {
     // If the game mode is HumanVsAI, Player X is Human and Player O is AI.
     if (am_mode == GameMode::HumanVsAI) {
-        m_playerX = std::make_unique<HumanPlayer>(CellState::X);  // Player X (Human)
-        m_playerO = std::make_unique<AIPlayer>(CellState::O);     // Player O (AI)
+        m_playerX = std::make_unique<HumanPlayer<TBoard>>(CellState::X);  // Player X (Human)
+        m_playerO = std::make_unique<TAIPlayer>(CellState::O, m_options);  // Player O (AI)
     }
     // If the game mode is HumanVsHuman, both Player X and Player O are Human.
     else {
-        m_playerX = std::make_unique<HumanPlayer>(CellState::X);  // Player X (Human)
-        m_playerO = std::make_unique<HumanPlayer>(CellState::O);  // Player O (Human)
+        m_playerX = std::make_unique<HumanPlayer<TBoard>>(CellState::X);  // Player X (Human)
+        m_playerO = std::make_unique<HumanPlayer<TBoard>>(CellState::O);  // Player O (Human)
     }
     
     // Set Player X to start the game
-    m_currentPlayer = std::move(m_playerX);
+    m_currentPlayer = m_playerX.get();
 }
 
 // Prints the welcome header for the game
-void Game::printHeader() const {
+template <typename TBoard, typename TAIPlayer>
+void Game<TBoard, TAIPlayer>::printHeader() const {
     std::cout << "Welcome to the game of TicTacToe!\n";  // Display game header
+    if constexpr (requires { TBoard::VARIANT_NAME; }) {
+        std::cout << "Variant: " << TBoard::VARIANT_NAME << "\n";  // Display the named variant
+    } else {
+        std::cout << "Board: " << TBoard::ROWS << "x" << TBoard::COLS << ", "
+                  << TBoard::WIN_LENGTH << " in a row wins.\n";  // Display the board variant
+    }
 }
 
 // Starts the game and manages the game loop
-void Game::play() {
+template <typename TBoard, typename TAIPlayer>
+void Game<TBoard, TAIPlayer>::play() {
     printHeader();  // Display the game header
 
     // Main game loop that continues until there's a winner or a draw
@@ -37,8 +49,13 @@ void Game::play() {
 
         std::cout << "Player " << m_currentPlayer->getSymbol() << " enter your move:" << std::endl;
 
-        // Let the current player make a move. If the move is invalid, prompt again.
-        if (!m_currentPlayer->makeMove(m_board)) {
+        // Let the waiting player ponder while the current one thinks, then let the current player make a move.
+        // If the move is invalid, prompt again.
+        Player<TBoard>* l_waitingPlayer = switchPlayer(m_gameMode);
+        l_waitingPlayer->startPondering(m_board);
+        const bool lb_moved = m_currentPlayer->makeMove(m_board);
+        l_waitingPlayer->stopPondering();
+        if (!lb_moved) {
             std::cerr << "Invalid input. Please try again." << std::endl;
             continue;  // Continue loop if the move was invalid
         }
@@ -63,21 +80,22 @@ void Game::play() {
 }
 
 // Switches the current player based on the symbol (X -> O, O -> X)
-// Takes into account the game mode (HumanVsHuman or HumanVsAI).
-std::unique_ptr<Player> Game::switchPlayer(const GameMode am_mode) const {
-    // In HumanVsAI mode, switch between Human (X) and AI (O) players.
-    if (m_gameMode == GameMode::HumanVsAI) {
-        if (m_currentPlayer->getSymbol() == CellState::X) {
-            return std::make_unique<AIPlayer>(CellState::O);  // Switch to player O (AI)
-        } else {
-            return std::make_unique<HumanPlayer>(CellState::X);  // Switch to player X (Human)
-        }
-    }
-
-    // In HumanVsHuman mode, switch between two Human players.
+// The players were created for the game mode (HumanVsHuman or HumanVsAI) by the constructor and are reused,
+// so the AI keeps what it learned on earlier moves.
+template <typename TBoard, typename TAIPlayer>
+Player<TBoard>* Game<TBoard, TAIPlayer>::switchPlayer(const GameMode am_mode) const {
     if (m_currentPlayer->getSymbol() == CellState::X) {
-        return std::make_unique<HumanPlayer>(CellState::O);  // Switch to player O (Human)
+        return m_playerO.get();  // Switch to player O (AI or Human)
     } else {
-        return std::make_unique<HumanPlayer>(CellState::X);  // Switch to player X (Human)
+        return m_playerX.get();  // Switch to player X (Human)
     }
-}
\ No newline at end of file
+}
+
+// Explicit instantiations for the board variants offered by the game
+template class Game<Board3x3>;
+template class Game<Board4x4>;
+template class Game<Board5x5>;
+template class Game<Board7x7>;
+template class Game<UltimateBoard, UltimateAIPlayer>;
+template class Game<UltimateBoard, MCTSPlayer<UltimateBoard>>;
+template class Game<QubicBoard, QubicAIPlayer>;
@@ -4,6 +4,10 @@
 #include <memory>
 #include "Board.h"
 #include "Player.h"
+#include "SearchOptions.h"
+
+template <typename TBoard>
+class AIPlayer;
 
 // Enum to define different game modes
 enum class GameMode {
@@ -13,27 +17,33 @@ enum class GameMode {
 
 // Class representing the game logic for Tic-Tac-Toe
 // Manages the game board, players, and handles the game flow.
+// TBoard selects the board variant (e.g. Board3x3 or Board7x7) the game is played on,
+// and TAIPlayer the AI that plays it in HumanVsAI mode.
+// Both players live for the whole game, so the AI keeps its tables and search tree from move to move,
+// and the player who is waiting may ponder while the other one thinks.
+template <typename TBoard, typename TAIPlayer = AIPlayer<TBoard>>
 class Game {
 
-    Board m_board;                            // The game board, containing the cells for X, O, or EMPTY
-    std::unique_ptr<Player> m_currentPlayer;  // The current player (either X or O)
-    std::unique_ptr<Player> m_playerO;        // Player O (initially AI)
-    std::unique_ptr<Player> m_playerX;        // Player X (initially Human)
-    GameMode m_gameMode;                     // The selected game mode (HumanVsHuman or HumanVsAI)
+    TBoard m_board;                                   // The game board, containing the cells for X, O, or EMPTY
+    std::unique_ptr<Player<TBoard>> m_playerO;        // Player O (initially AI)
+    std::unique_ptr<Player<TBoard>> m_playerX;        // Player X (initially Human)
+    Player<TBoard>* m_currentPlayer;                  // The current player, either m_playerX or m_playerO
+    GameMode m_gameMode;                             // The selected game mode (HumanVsHuman or HumanVsAI)
+    SearchOptions m_options;                         // Settings passed to the AI player the game creates
 
 public:
     // Constructor to initialize the game with the selected game mode.
     // Sets up Player X as Human and Player O as AI if GameMode is HumanVsAI,
-    // or both as Human if GameMode is HumanVsHuman.
-    Game(GameMode);
+    // or both as Human if GameMode is HumanVsHuman. a_options configures the AI player.
+    Game(GameMode, const SearchOptions& a_options = {});
 
     // Method to start and run the game loop.
     // The loop continues until there's a winner or a draw
     void play();
 
-    // Method to switch between players (X -> O, O -> X) based on the current player and game mode.
-    // This handles alternating between human players and switching to AI where applicable.
-    [[nodiscard]] std::unique_ptr<Player> switchPlayer(GameMode am_mode) const;
+    // Method to switch between players (X -> O, O -> X) based on the current player.
+    // Returns the other of the two players created for the game; the game mode only decided which kinds they are.
+    [[nodiscard]] Player<TBoard>* switchPlayer(GameMode am_mode) const;
 
 private:
     // Method to print the game header and welcome message.
@@ -41,4 +51,4 @@ private:
     void printHeader() const;
 };
 
-#endif // GAME_H
\ No newline at end of file
+#endif // GAME_H
@@ -1,6 +1,8 @@
 #include "HumanPlayer.h"
 #include <iostream>
 #include <limits>  // For std::numeric_limits to handle invalid input
+#include "QubicBoard.h"
+#include "UltimateBoard.h"
 
 /**
  * Allows the human player to make a move on the game board.
@@ -9,10 +11,11 @@
  * @param a_board The board where the move is to be made
  * @return true if the move is valid and successful, false otherwise
  */
-bool HumanPlayer::makeMove(Board& a_board) {
-    int move = 0;  // The move the player wants to make (1-9)
+template <typename TBoard>
+bool HumanPlayer<TBoard>::makeMove(TBoard& a_board) {
+    int move = 0;  // The move the player wants to make (1-SIZE)
 
-    std::cout << "Enter your move (1-9): ";  // Prompt the player to enter their move
+    std::cout << "Enter your move (1-" << TBoard::SIZE << "): ";  // Prompt the player to enter their move
 
     std::cin >> move;  // Read the player's input (move)
 
@@ -20,17 +23,25 @@ bool HumanPlayer::makeMove(Board& a_board) {
     if (std::cin.fail()) {
         std::cin.clear();  // Clear the error flag on cin
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');  // Ignore the invalid input
-        std::cerr << "Invalid input! Please enter a number between 1 and 9.\n";
+        std::cerr << "Invalid input! Please enter a number between 1 and " << TBoard::SIZE << ".\n";
         return false;  // Return false if the input was invalid
     }
 
     // Check if the move is within the valid range and if the chosen cell is empty
-    if (move < 1 || move > 9 || !a_board.checkMove(move)) {
+    if (move < 1 || move > TBoard::SIZE || !a_board.checkMove(move)) {
         std::cerr << "Invalid move! The position is either out of range or already occupied.\n";
         return false;  // Return false if the move is out of range or the cell is occupied
     }
 
     // If the move is valid, make the move on the board
-    a_board.makeMove(m_player, move);
+    a_board.pushMove(m_player, move);
     return true;  // Return true if the move was successfully made
 }
+
+// Explicit instantiations for the board variants offered by the game
+template class HumanPlayer<Board3x3>;
+template class HumanPlayer<Board4x4>;
+template class HumanPlayer<Board5x5>;
+template class HumanPlayer<Board7x7>;
+template class HumanPlayer<UltimateBoard>;
+template class HumanPlayer<QubicBoard>;
@@ -5,19 +5,22 @@
 
 // Class representing a human player in the Tic-Tac-Toe game
 // Inherits from Player and allows the human player to make moves on the board.
-class HumanPlayer final : public Player {
+template <typename TBoard>
+class HumanPlayer final : public Player<TBoard> {
+    using Player<TBoard>::m_player;
+
 public:
     // Constructors and destructors
     // Default constructor, sets the symbol to EMPTY (no symbol initially)
     HumanPlayer() = default;
     // Constructor that initializes the player's symbol (X or O)
-    explicit HumanPlayer(const CellState ac_player) : Player(ac_player) {}
+    explicit HumanPlayer(const CellState ac_player) : Player<TBoard>(ac_player) {}
     // Default destructor
     ~HumanPlayer() override = default;
 
     // FUnctions
     // Override the makeMove method to allow the human player to make a move
-    bool makeMove(Board& a_board) override;
+    bool makeMove(TBoard& a_board) override;
 
     // Override the getSymbol method to return the player's symbol (X or O)
     [[nodiscard]] CellState getSymbol() const override { return m_player; }
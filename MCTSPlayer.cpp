@@ -0,0 +1,496 @@
+#include "MCTSPlayer.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include "SparseBoard.h"
+#include "ThreatSearch.h"
+#include "UltimateBoard.h"
+
+namespace {
+
+constexpr double EXPLORATION = 1.4;              // UCT exploration constant, close to the textbook sqrt(2)
+constexpr std::uint32_t EXPAND_VISITS = 2;       // Visits a leaf needs before its children are added
+constexpr std::uint64_t PLAYOUT_BATCH = 64;      // Playouts a thread runs between budget checks
+
+// Ultimate boards have no threat-space search: a line on a small board does not decide the game
+bool findForcedWin(const UltimateBoard &, std::int32_t &) {
+    return false;
+}
+
+// Runs the threat-space search on a sparse board, and gives the first move of a forced win if it finds one
+bool findForcedWin(const SparseBoard &a_board, std::int32_t &ai_move) {
+    ThreatSearch l_search;
+    std::vector<SparseBoard::Move> l_line;
+    if (!l_search.findWin(a_board, l_line)) {
+        return false;
+    }
+    ai_move = l_line.front();
+    return true;
+}
+
+// Lists the legal moves of an Ultimate board
+void listMoves(const UltimateBoard &a_board, std::vector<std::int32_t> &a_moves) {
+    std::array<std::uint8_t, UltimateBoard::SIZE> l_moves;
+    const int li_count = a_board.generateMoves(l_moves);
+    a_moves.assign(l_moves.begin(), l_moves.begin() + li_count);
+}
+
+// Lists the candidate moves of a sparse board: the empty cells near the stones
+void listMoves(const SparseBoard &a_board, std::vector<SparseBoard::Move> &a_moves) {
+    a_board.generateMoves(a_moves);
+}
+
+// Brings the move list up to date after a playout move. The next-board rule can change every Ultimate move,
+// so the list is simply generated again.
+void updateMoves(const UltimateBoard &a_board, std::vector<std::int32_t> &a_moves, std::int32_t) {
+    listMoves(a_board, a_moves);
+}
+
+// On a sparse board only the played cell leaves the list and the empty cells around it join it, which
+// is much cheaper than walking every neighbour count again. The order differs from generateMoves, the set does not.
+void updateMoves(const SparseBoard &a_board, std::vector<SparseBoard::Move> &a_moves, const SparseBoard::Move ai_played) {
+    const auto l_played = std::find(a_moves.begin(), a_moves.end(), ai_played);
+    if (l_played != a_moves.end()) {
+        *l_played = a_moves.back();
+        a_moves.pop_back();
+    }
+    const int li_row = SparseBoard::moveRow(ai_played), li_col = SparseBoard::moveCol(ai_played);
+    for (int row = li_row - SparseBoard::NEIGHBOUR_RADIUS; row <= li_row + SparseBoard::NEIGHBOUR_RADIUS; ++row) {
+        for (int col = li_col - SparseBoard::NEIGHBOUR_RADIUS; col <= li_col + SparseBoard::NEIGHBOUR_RADIUS; ++col) {
+            const SparseBoard::Move lu_move = SparseBoard::encodeMove(row, col);
+            if (a_board.checkMove(lu_move) && std::find(a_moves.begin(), a_moves.end(), lu_move) == a_moves.end()) {
+                a_moves.push_back(lu_move);
+            }
+        }
+    }
+}
+
+// Prints the move the AI chose in the notation the human player types
+void printMove(const UltimateBoard &, const std::int32_t ai_move) {
+    std::cout << "AI makes a move at position: " << ai_move << std::endl;
+}
+
+void printMove(const SparseBoard &, const SparseBoard::Move ai_move) {
+    std::cout << "AI makes a move at row " << SparseBoard::moveRow(ai_move) << ", column " << SparseBoard::moveCol(ai_move) << std::endl;
+}
+
+// Returns the winner of a finished game, or EMPTY if nobody has won (yet)
+template <typename TBoard>
+CellState winnerOf(const TBoard &a_board) {
+    if (a_board.checkWin(CellState::X)) return CellState::X;
+    if (a_board.checkWin(CellState::O)) return CellState::O;
+    return CellState::EMPTY;
+}
+
+// Advances a xorshift64 generator and returns a number below ai_bound
+std::uint32_t nextRandom(std::uint64_t &a_state, const std::size_t au_bound) {
+    a_state ^= a_state << 13;
+    a_state ^= a_state >> 7;
+    a_state ^= a_state << 17;
+    return static_cast<std::uint32_t>(((a_state >> 32) * au_bound) >> 32);
+}
+
+} // namespace
+
+/**
+ * Reserves contiguous nodes. Several threads may allocate at once; the count never exceeds the capacity.
+ *
+ * @param au_count The number of nodes needed
+ * @return The index of the first node, or NO_NODE if the arena is full
+ */
+template <typename TBoard>
+std::uint32_t MCTSPlayer<TBoard>::Arena::allocate(const std::uint32_t au_count) {
+    std::uint32_t lu_used = used.load(std::memory_order_relaxed);
+    do {
+        if (capacity - lu_used < au_count) return NO_NODE;
+    } while (!used.compare_exchange_weak(lu_used, lu_used + au_count, std::memory_order_relaxed));
+    return lu_used;
+}
+
+// Constructor that sets the player's symbol and budget, allocates the two arenas within the configured
+// table memory, and creates one worker per thread
+template <typename TBoard>
+MCTSPlayer<TBoard>::MCTSPlayer(const CellState ac_player, const SearchOptions& a_options)
+    : Player<TBoard>(ac_player), m_moveTime(a_options.moveTime),
+      m_playoutLimit(a_options.nodeLimit != 0 ? a_options.nodeLimit : UINT64_MAX) {
+    const std::size_t lu_nodes = std::clamp<std::size_t>(a_options.tableMegabytes * 1024 * 1024 / sizeof(Node) / 2, 1, NO_NODE - 1);
+    for (Arena& l_arena : m_arenas) {
+        l_arena.nodes = std::make_unique<Node[]>(lu_nodes);
+        l_arena.capacity = static_cast<std::uint32_t>(lu_nodes);
+    }
+
+    const int li_threads = std::max(a_options.threads, 1);
+    std::random_device l_seed;
+    for (int i = 0; i < li_threads; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+        m_workers.back()->random = (static_cast<std::uint64_t>(l_seed()) << 32 | l_seed()) | 1;  // xorshift needs a non-zero state
+    }
+    if (li_threads > 1) {
+        m_pool = std::make_unique<ThreadPool>(li_threads);
+    }
+}
+
+// Destructor that waits for a pondering search to stop before the tree it grows is freed
+template <typename TBoard>
+MCTSPlayer<TBoard>::~MCTSPlayer() {
+    stopPondering();
+}
+
+/**
+ * Makes the current position the root of the tree. If the opponent answered the move chosen last turn
+ * with a move the tree already explored, that subtree is kept with all its statistics; otherwise the
+ * tree is dropped and a new one is started.
+ *
+ * @param a_board The current game board
+ */
+template <typename TBoard>
+void MCTSPlayer<TBoard>::prepareRoot(const TBoard &a_board) {
+    if (m_played != NO_NODE) {
+        const Node& l_played = m_arenas[m_arena].nodes[m_played];
+        std::uint32_t lu_found = a_board.getHash() == m_playedBoard.getHash() ? m_played : NO_NODE;
+        if (lu_found == NO_NODE && l_played.expansion.load(std::memory_order_relaxed) == Expansion::DONE) {
+            const CellState lc_opponent = opponentOf(m_player);
+            for (std::uint32_t i = 0; i < l_played.childCount && lu_found == NO_NODE; ++i) {
+                const std::uint32_t lu_child = l_played.firstChild + i;
+                m_playedBoard.pushMove(lc_opponent, m_arenas[m_arena].nodes[lu_child].move);
+                if (m_playedBoard.getHash() == a_board.getHash()) lu_found = lu_child;
+                m_playedBoard.popMove();
+            }
+        }
+        m_played = NO_NODE;
+        if (lu_found != NO_NODE) {
+            m_root = moveSubtree(lu_found);
+            return;
+        }
+    }
+
+    Arena& l_arena = m_arenas[m_arena];
+    l_arena.used.store(0, std::memory_order_relaxed);
+    m_root = l_arena.allocate(1);
+    Node& l_root = l_arena.nodes[m_root];
+    l_root.visits.store(0, std::memory_order_relaxed);
+    l_root.score.store(0, std::memory_order_relaxed);
+    l_root.expansion.store(Expansion::NONE, std::memory_order_relaxed);
+    l_root.firstChild = NO_NODE;
+    l_root.childCount = 0;
+    l_root.move = 0;
+}
+
+/**
+ * Copies a subtree, breadth first, into the spare arena and makes that arena the current one.
+ * The subtree is part of the current tree, so it always fits.
+ *
+ * @param au_node The root of the subtree in the current arena
+ * @return The index of the subtree's root in the new arena
+ */
+template <typename TBoard>
+std::uint32_t MCTSPlayer<TBoard>::moveSubtree(const std::uint32_t au_node) {
+    Arena& l_from = m_arenas[m_arena];
+    Arena& l_to = m_arenas[1 - m_arena];
+    l_to.used.store(0, std::memory_order_relaxed);
+
+    const auto lf_copy = [&](const std::uint32_t au_source, const std::uint32_t au_target) {
+        const Node& l_source = l_from.nodes[au_source];
+        Node& l_target = l_to.nodes[au_target];
+        l_target.visits.store(l_source.visits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        l_target.score.store(l_source.score.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        l_target.expansion.store(Expansion::NONE, std::memory_order_relaxed);
+        l_target.firstChild = NO_NODE;
+        l_target.childCount = 0;
+        l_target.move = l_source.move;
+    };
+
+    const std::uint32_t lu_root = l_to.allocate(1);
+    lf_copy(au_node, lu_root);
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> l_queue{{au_node, lu_root}};  // (source, target) pairs still to copy
+    for (std::size_t q = 0; q < l_queue.size(); ++q) {
+        const auto [lu_source, lu_target] = l_queue[q];
+        const Node& l_source = l_from.nodes[lu_source];
+        if (l_source.expansion.load(std::memory_order_relaxed) != Expansion::DONE) continue;
+
+        const std::uint32_t lu_children = l_to.allocate(l_source.childCount);
+        for (std::uint32_t i = 0; i < l_source.childCount; ++i) {
+            lf_copy(l_source.firstChild + i, lu_children + i);
+            l_queue.emplace_back(l_source.firstChild + i, lu_children + i);
+        }
+        Node& l_target = l_to.nodes[lu_target];
+        l_target.firstChild = lu_children;
+        l_target.childCount = l_source.childCount;
+        l_target.expansion.store(Expansion::DONE, std::memory_order_relaxed);
+    }
+
+    m_arena = 1 - m_arena;
+    return lu_root;
+}
+
+/**
+ * Adds one child per legal move to a leaf. Only one thread may expand a node: the others find it busy
+ * and run their playout from the leaf instead.
+ *
+ * @param a_node The leaf to expand; its position is on the worker's board
+ * @param a_worker The expanding thread
+ * @return true if the children were added, false otherwise
+ */
+template <typename TBoard>
+bool MCTSPlayer<TBoard>::expand(Node &a_node, Worker &a_worker) {
+    Expansion lc_expected = Expansion::NONE;
+    if (!a_node.expansion.compare_exchange_strong(lc_expected, Expansion::BUSY, std::memory_order_relaxed)) {
+        return false;
+    }
+
+    listMoves(a_worker.board, a_worker.moves);
+    Arena& l_arena = m_arenas[m_arena];
+    const auto lu_count = static_cast<std::uint32_t>(a_worker.moves.size());
+    const std::uint32_t lu_first = lu_count > 0 ? l_arena.allocate(lu_count) : NO_NODE;
+    if (lu_first == NO_NODE) {
+        a_node.expansion.store(Expansion::NONE, std::memory_order_relaxed);  // The tree stops growing, playouts go on
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < lu_count; ++i) {
+        Node& l_child = l_arena.nodes[lu_first + i];
+        l_child.visits.store(0, std::memory_order_relaxed);
+        l_child.score.store(0, std::memory_order_relaxed);
+        l_child.expansion.store(Expansion::NONE, std::memory_order_relaxed);
+        l_child.firstChild = NO_NODE;
+        l_child.childCount = 0;
+        l_child.move = a_worker.moves[i];
+    }
+    a_node.firstChild = lu_first;
+    a_node.childCount = lu_count;
+    a_node.expansion.store(Expansion::DONE, std::memory_order_release);  // Publishes the children to the other threads
+    return true;
+}
+
+/**
+ * Chooses the child with the highest upper confidence bound: its average result plus an exploration bonus
+ * that shrinks the more often it was visited. Children nobody has visited yet are tried first, in move order.
+ * Visits still running count with no score, so a branch other threads are exploring looks worse for a while.
+ *
+ * @param a_node An expanded node
+ * @return The arena index of the chosen child
+ */
+template <typename TBoard>
+std::uint32_t MCTSPlayer<TBoard>::selectChild(const Node &a_node) const {
+    const Node* l_nodes = m_arenas[m_arena].nodes.get();
+    const double lf_logVisits = std::log(static_cast<double>(std::max<std::uint32_t>(a_node.visits.load(std::memory_order_relaxed), 1)));
+    std::uint32_t lu_best = a_node.firstChild;
+    double lf_bestValue = -1;
+    for (std::uint32_t i = a_node.firstChild; i < a_node.firstChild + a_node.childCount; ++i) {
+        const std::uint32_t lu_visits = l_nodes[i].visits.load(std::memory_order_relaxed);
+        if (lu_visits == 0) return i;
+        const double lf_value = l_nodes[i].score.load(std::memory_order_relaxed) / (2.0 * lu_visits)
+                              + EXPLORATION * std::sqrt(lf_logVisits / lu_visits);
+        if (lf_value > lf_bestValue) {
+            lf_bestValue = lf_value;
+            lu_best = i;
+        }
+    }
+    return lu_best;
+}
+
+/**
+ * Plays random moves until the game ends, then takes them all back.
+ * A game still undecided after MAX_PLAYOUT_PLIES moves (only possible on the infinite board) is scored as a draw.
+ *
+ * @param a_worker The thread whose board holds the starting position
+ * @return The winner, or EMPTY for a draw
+ */
+template <typename TBoard>
+CellState MCTSPlayer<TBoard>::playout(Worker &a_worker) {
+    TBoard& l_board = a_worker.board;
+    CellState lc_winner = winnerOf(l_board);
+    int li_plies = 0;
+    listMoves(l_board, a_worker.moves);
+    while (lc_winner == CellState::EMPTY && li_plies < MAX_PLAYOUT_PLIES && !a_worker.moves.empty()) {
+        const CellState lc_mover = l_board.getSideToMove();
+        const Move li_move = a_worker.moves[nextRandom(a_worker.random, a_worker.moves.size())];
+        if (l_board.pushMove(lc_mover, li_move)) {
+            lc_winner = lc_mover;
+        }
+        updateMoves(l_board, a_worker.moves, li_move);
+        ++li_plies;
+    }
+    for (int i = 0; i < li_plies; ++i) {
+        l_board.popMove();
+    }
+    return lc_winner;
+}
+
+/**
+ * Runs one iteration from the root: descends by selectChild while the nodes are expanded, counting the visit
+ * of every node on the way, expands the leaf once it has been visited often enough, finishes the game with
+ * a playout, and adds the result to every node on the path from the point of view of the player who moved into it.
+ *
+ * @param a_worker The searching thread, whose board holds the root position
+ */
+template <typename TBoard>
+void MCTSPlayer<TBoard>::iterate(Worker &a_worker) {
+    Node* l_nodes = m_arenas[m_arena].nodes.get();
+    a_worker.path.clear();
+    a_worker.path.push_back(m_root);
+    l_nodes[m_root].visits.fetch_add(1, std::memory_order_relaxed);
+
+    const CellState lc_rootMover = opponentOf(a_worker.board.getSideToMove());  // Made the move into the root
+    while (winnerOf(a_worker.board) == CellState::EMPTY && !a_worker.board.checkDraw()) {
+        Node& l_node = l_nodes[a_worker.path.back()];
+        Expansion lc_expansion = l_node.expansion.load(std::memory_order_acquire);
+        if (lc_expansion == Expansion::NONE && (a_worker.path.size() == 1 || l_node.visits.load(std::memory_order_relaxed) >= EXPAND_VISITS)) {
+            lc_expansion = expand(l_node, a_worker) ? Expansion::DONE : Expansion::NONE;
+        }
+        if (lc_expansion != Expansion::DONE) break;
+
+        const std::uint32_t lu_child = selectChild(l_node);
+        l_nodes[lu_child].visits.fetch_add(1, std::memory_order_relaxed);  // Virtual loss until the result is added
+        a_worker.board.pushMove(a_worker.board.getSideToMove(), l_nodes[lu_child].move);
+        a_worker.path.push_back(lu_child);
+    }
+
+    const CellState lc_winner = playout(a_worker);
+    for (std::size_t i = 0; i < a_worker.path.size(); ++i) {
+        const CellState lc_mover = i % 2 == 0 ? lc_rootMover : opponentOf(lc_rootMover);
+        const std::uint32_t lu_score = lc_winner == CellState::EMPTY ? 1 : lc_winner == lc_mover ? 2 : 0;
+        if (lu_score != 0) l_nodes[a_worker.path[i]].score.fetch_add(lu_score, std::memory_order_relaxed);
+    }
+    for (std::size_t i = 1; i < a_worker.path.size(); ++i) {
+        a_worker.board.popMove();
+    }
+}
+
+/**
+ * Runs iterations until the deadline or the playout limit, or until pondering is called off. Playouts are
+ * added to the shared count in batches, so the threads rarely touch the same counter.
+ *
+ * @param a_worker The searching thread
+ */
+template <typename TBoard>
+void MCTSPlayer<TBoard>::runIterations(Worker &a_worker) {
+    while (true) {
+        for (std::uint64_t i = 0; i < PLAYOUT_BATCH; ++i) {
+            iterate(a_worker);
+        }
+        const std::uint64_t lu_total = m_playouts.fetch_add(PLAYOUT_BATCH, std::memory_order_relaxed) + PLAYOUT_BATCH;
+        if (lu_total >= m_playoutLimit || std::chrono::steady_clock::now() >= m_deadline || m_ponderStopped.load(std::memory_order_relaxed)) {
+            return;
+        }
+    }
+}
+
+/**
+ * Makes the position the root, keeping the subtree searched for it earlier, and runs iterations on every
+ * thread until the budget is spent. A root with a single child is not searched.
+ *
+ * @param a_board The position to search
+ */
+template <typename TBoard>
+void MCTSPlayer<TBoard>::growTree(const TBoard &a_board) {
+    prepareRoot(a_board);
+    for (const auto& l_worker : m_workers) {
+        l_worker->board = a_board;
+    }
+
+    if (m_arenas[m_arena].nodes[m_root].expansion.load(std::memory_order_relaxed) != Expansion::DONE &&
+        !expand(m_arenas[m_arena].nodes[m_root], *m_workers[0])) {
+        prepareRoot(a_board);  // The kept subtree left no room for the root's children, start over with an empty tree
+        expand(m_arenas[m_arena].nodes[m_root], *m_workers[0]);
+    }
+    if (m_arenas[m_arena].nodes[m_root].childCount > 1) {
+        if (m_pool) {
+            m_pool->parallelFor(m_pool->getThreadCount(), [this](const int, const int ai_worker) { runIterations(*m_workers[ai_worker]); });
+        } else {
+            runIterations(*m_workers[0]);
+        }
+    }
+}
+
+/**
+ * Finds the best move by growing the search tree until the budget runs out and picking the root child
+ * with the most visits, which is more reliable than the best average. A single legal move is played at once.
+ * On the sparse board a threat-space search runs first, and a forced win it finds is played without
+ * growing the tree; the tree is then dropped, since it was not grown along the winning line.
+ *
+ * @param a_board The current game board, with the AI to move
+ * @return The chosen move
+ */
+template <typename TBoard>
+typename MCTSPlayer<TBoard>::Move MCTSPlayer<TBoard>::findBestMove(const TBoard &a_board) {
+    stopPondering();  // The opponent has moved, so the tree grown on their time is kept from here
+    m_deadline = std::chrono::steady_clock::now() + m_moveTime;
+    m_playouts.store(0, std::memory_order_relaxed);
+    if (Move li_move = 0; findForcedWin(a_board, li_move)) {
+        m_played = NO_NODE;
+        return li_move;
+    }
+    growTree(a_board);
+    const Node* l_nodes = m_arenas[m_arena].nodes.get();
+
+    const Node& l_root = l_nodes[m_root];
+    std::uint32_t lu_best = l_root.firstChild;
+    for (std::uint32_t i = l_root.firstChild; i < l_root.firstChild + l_root.childCount; ++i) {
+        const std::uint32_t lu_visits = l_nodes[i].visits.load(std::memory_order_relaxed);
+        const std::uint32_t lu_bestVisits = l_nodes[lu_best].visits.load(std::memory_order_relaxed);
+        if (lu_visits > lu_bestVisits || (lu_visits == lu_bestVisits && l_nodes[i].score.load(std::memory_order_relaxed) > l_nodes[lu_best].score.load(std::memory_order_relaxed))) {
+            lu_best = i;
+        }
+    }
+
+    // Remember where the tree continues, so the next search can start from the opponent's reply
+    m_played = lu_best;
+    m_playedBoard = a_board;
+    m_playedBoard.pushMove(m_player, l_nodes[lu_best].move);
+    return l_nodes[lu_best].move;
+}
+
+/**
+ * Starts growing the tree of the position the opponent is to move in on a background thread. The subtree
+ * of the move chosen last turn becomes the root, so the search started then simply goes on.
+ *
+ * @param a_board The current game board, with the opponent to move
+ */
+template <typename TBoard>
+void MCTSPlayer<TBoard>::startPondering(const TBoard &a_board) {
+    stopPondering();
+    if (winnerOf(a_board) != CellState::EMPTY || a_board.checkDraw()) {
+        return;
+    }
+    m_ponderThread = std::thread([this, a_board] {
+        m_deadline = std::chrono::steady_clock::time_point::max();  // Only stopPondering or the playout limit ends it
+        m_playouts.store(0, std::memory_order_relaxed);
+        growTree(a_board);
+        // The root is now the position the opponent moves in, and its children are their replies
+        m_played = m_root;
+        m_playedBoard = a_board;
+    });
+}
+
+/**
+ * Stops pondering and waits for the thread to finish. The tree keeps every playout run so far.
+ */
+template <typename TBoard>
+void MCTSPlayer<TBoard>::stopPondering() {
+    if (!m_ponderThread.joinable()) {
+        return;
+    }
+    m_ponderStopped.store(true, std::memory_order_relaxed);
+    m_ponderThread.join();
+    m_ponderStopped.store(false, std::memory_order_relaxed);
+}
+
+/**
+ * Makes the move found by the tree search.
+ *
+ * @param a_board The board where the AI will make its move
+ * @return true to indicate the move was made
+ */
+template <typename TBoard>
+bool MCTSPlayer<TBoard>::makeMove(TBoard &a_board) {
+    const Move li_bestMove = findBestMove(a_board);
+    a_board.pushMove(m_player, li_bestMove);
+    printMove(a_board, li_bestMove);
+    return true;
+}
+
+// Explicit instantiations for the boards too large for a full search
+template class MCTSPlayer<UltimateBoard>;
+template class MCTSPlayer<SparseBoard>;
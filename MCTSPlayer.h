@@ -0,0 +1,133 @@
+#ifndef MCTSPLAYER_H
+#define MCTSPLAYER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "Player.h"
+#include "SearchOptions.h"
+#include "ThreadPool.h"
+
+// Class representing a Monte Carlo tree search AI, for boards whose game tree is too large for alpha-beta
+// to see far ahead: Ultimate Tic-Tac-Toe (UltimateBoard) and Gomoku (SparseBoard).
+// Every iteration walks down the tree choosing children by UCT, adds the children of the leaf it reaches,
+// finishes the game with random moves, and credits the result to every node on the way down.
+// Several threads grow one shared tree. A thread counts its visit to a node before its playout ends, so until
+// the result arrives the visit looks like a loss (a virtual loss) and the other threads try different branches.
+// Nodes come from a fixed arena instead of the heap, and the subtree of the position after the opponent's reply
+// is moved into a fresh arena and searched further on the next turn. While the opponent thinks, the AI can keep
+// growing the tree from the position they are to move in, so whatever they reply, its subtree is already searched.
+template <typename TBoard>
+class MCTSPlayer final : public Player<TBoard> {
+    using Player<TBoard>::m_player;
+
+public:
+    using Move = std::int32_t;  // A move of TBoard as passed to pushMove: a move number or a packed SparseBoard move
+
+    // Constructor initializes the AI player's symbol, its budget per move, its tree memory, and its search threads
+    explicit MCTSPlayer(CellState ac_player, const SearchOptions& a_options = {});
+
+    // Destructor stops a search still pondering in the background
+    ~MCTSPlayer() override;
+
+    // Override the makeMove method to allow the AI player to make a move
+    bool makeMove(TBoard &a_board) override;
+
+    // Override the getSymbol method to return the AI player's symbol (X or O)
+    [[nodiscard]] CellState getSymbol() const override { return m_player; }
+
+    // Override the pondering functions to grow the tree while the opponent thinks
+    void startPondering(const TBoard &a_board) override;
+    void stopPondering() override;
+
+    // Function to find the move played most often during a search within the budget
+    Move findBestMove(const TBoard &a_board);
+
+    // Function to get the playouts run by all threads during the last search
+    [[nodiscard]] std::uint64_t getPlayoutCount() const { return m_playouts.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::uint32_t NO_NODE = UINT32_MAX;   // Index meaning "no node"
+    static constexpr int MAX_PLAYOUT_PLIES = 200;          // Playouts still undecided after this many moves count as draws
+
+    // Whether the children of a node have been added
+    enum class Expansion : std::uint8_t {
+        NONE,  // Not yet, the node is a leaf
+        BUSY,  // A thread is adding them right now
+        DONE   // firstChild and childCount are valid
+    };
+
+    // One position of the tree, reached from its parent by move. The counters are shared by all threads.
+    struct Node {
+        std::atomic<std::uint32_t> visits{0};               // Iterations through this node, including unfinished ones
+        std::atomic<std::uint32_t> score{0};                // Playout results for the player who made move: 2 per win, 1 per draw
+        std::atomic<Expansion> expansion{Expansion::NONE};  // Published with release order once the children exist
+        std::uint32_t firstChild = NO_NODE;                 // Arena index of the first child; siblings are contiguous
+        std::uint32_t childCount = 0;                       // Number of children
+        Move move = 0;                                      // The move leading to this position
+    };
+
+    // Fixed block of nodes handed out by bumping an index: allocating is one atomic operation
+    // and dropping the whole tree is a reset of the index
+    struct Arena {
+        std::unique_ptr<Node[]> nodes;           // The node storage
+        std::uint32_t capacity = 0;              // Number of nodes in the storage
+        std::atomic<std::uint32_t> used{0};      // Nodes handed out since the last reset
+
+        std::uint32_t allocate(std::uint32_t au_count);  // Reserve au_count contiguous nodes, NO_NODE if they do not fit
+    };
+
+    // Everything one search thread changes while it searches, apart from the shared tree
+    struct Worker {
+        TBoard board;                            // The thread's own copy of the position
+        std::vector<Move> moves;                 // Scratch list of legal moves
+        std::vector<std::uint32_t> path;         // Nodes visited by the current iteration, root first
+        std::uint64_t random = 0;                // State of the thread's xorshift random generator
+    };
+
+    std::chrono::milliseconds m_moveTime;                   // Thinking time per move
+    std::uint64_t m_playoutLimit;                           // Playouts allowed per move
+    std::chrono::steady_clock::time_point m_deadline;       // When the current search has to stop
+    std::atomic<std::uint64_t> m_playouts{0};               // Playouts run by all threads, counted in batches
+
+    std::array<Arena, 2> m_arenas;                          // The tree, and the space the kept subtree is moved to
+    int m_arena = 0;                                        // Index of the arena holding the current tree
+    std::uint32_t m_root = NO_NODE;                         // Root of the current tree
+    std::uint32_t m_played = NO_NODE;                       // Node of the move chosen last turn, whose subtree may be kept
+    TBoard m_playedBoard;                                   // The position after the move chosen last turn
+
+    std::vector<std::unique_ptr<Worker>> m_workers;         // One per search thread, indexed by worker
+    std::unique_ptr<ThreadPool> m_pool;                     // Threads growing the tree, null when searching on one thread
+    std::thread m_ponderThread;                             // Grows the tree while the opponent thinks
+    std::atomic<bool> m_ponderStopped{false};               // Set to make the pondering search give up
+
+    // Function to make the position after the opponent's reply the root, keeping its subtree if it was searched
+    void prepareRoot(const TBoard &a_board);
+
+    // Function to copy a subtree into the spare arena, which then becomes the current one, returns its new root
+    std::uint32_t moveSubtree(std::uint32_t au_node);
+
+    // Function to add the children of a leaf, returns false if another thread is adding them or the arena is full
+    bool expand(Node &a_node, Worker &a_worker);
+
+    // Function to choose the child to descend to by UCT
+    [[nodiscard]] std::uint32_t selectChild(const Node &a_node) const;
+
+    // Function to finish the game on the worker's board with random moves, returns the winner or EMPTY for a draw
+    CellState playout(Worker &a_worker);
+
+    // Function to run one iteration: selection, expansion, playout, and backpropagation
+    void iterate(Worker &a_worker);
+
+    // Function to run iterations on one thread until the time or playout budget is spent
+    void runIterations(Worker &a_worker);
+
+    // Function to make a position the root and grow its tree on every thread until the budget is spent
+    void growTree(const TBoard &a_board);
+};
+
+#endif // MCTSPLAYER_H
@@ -0,0 +1,151 @@
+#include "OpeningBook.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Destructor that unmaps the book file, if one is open
+OpeningBook::~OpeningBook() {
+    close();
+}
+
+/**
+ * Maps a book file read-only and checks its header. Nothing is read or copied beyond the header;
+ * the entries are used in place, and the operating system pages them in as lookups touch them.
+ * An open book is closed first.
+ *
+ * @param as_path The book file
+ * @return true if the book is open, false if the file is missing, truncated, or of another format or byte order
+ */
+bool OpeningBook::open(const std::string& as_path) {
+    close();
+
+#ifdef _WIN32
+    m_file = CreateFileA(as_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        m_file = nullptr;
+        return false;
+    }
+    LARGE_INTEGER l_size;
+    if (!GetFileSizeEx(m_file, &l_size) || l_size.QuadPart < static_cast<LONGLONG>(sizeof(Header))) {
+        close();
+        return false;
+    }
+    m_mappingHandle = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    m_mapping = m_mappingHandle ? MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    m_mappingSize = static_cast<std::size_t>(l_size.QuadPart);
+#else
+    const int li_file = ::open(as_path.c_str(), O_RDONLY);
+    if (li_file < 0) {
+        return false;
+    }
+    struct stat l_stat {};
+    if (fstat(li_file, &l_stat) != 0 || l_stat.st_size < static_cast<off_t>(sizeof(Header))) {
+        ::close(li_file);
+        return false;
+    }
+    void* l_mapping = mmap(nullptr, static_cast<std::size_t>(l_stat.st_size), PROT_READ, MAP_SHARED, li_file, 0);
+    ::close(li_file);  // The mapping keeps the file alive
+    if (l_mapping != MAP_FAILED) {
+        m_mapping = l_mapping;
+        m_mappingSize = static_cast<std::size_t>(l_stat.st_size);
+        madvise(l_mapping, m_mappingSize, MADV_RANDOM);  // Binary searches jump around, so read-ahead would be wasted
+    }
+#endif
+    if (m_mapping == nullptr) {
+        close();
+        return false;
+    }
+
+    const auto* l_header = static_cast<const Header*>(m_mapping);
+    const bool lb_valid = std::memcmp(l_header->magic, MAGIC, sizeof(MAGIC)) == 0 && l_header->version == FORMAT_VERSION &&
+                          l_header->byteOrderMark == BYTE_ORDER_MARK &&
+                          l_header->entryCount == (m_mappingSize - sizeof(Header)) / sizeof(Entry) &&
+                          (m_mappingSize - sizeof(Header)) % sizeof(Entry) == 0;
+    if (!lb_valid) {
+        close();
+        return false;
+    }
+    m_header = l_header;
+    m_entries = reinterpret_cast<const Entry*>(static_cast<const char*>(m_mapping) + sizeof(Header));
+    return true;
+}
+
+// Unmaps the book file; the book is empty afterwards
+void OpeningBook::close() {
+#ifdef _WIN32
+    if (m_mapping) UnmapViewOfFile(m_mapping);
+    if (m_mappingHandle) CloseHandle(m_mappingHandle);
+    if (m_file) CloseHandle(m_file);
+    m_mappingHandle = nullptr;
+    m_file = nullptr;
+#else
+    if (m_mapping) munmap(const_cast<void*>(m_mapping), m_mappingSize);
+#endif
+    m_mapping = nullptr;
+    m_mappingSize = 0;
+    m_header = nullptr;
+    m_entries = nullptr;
+}
+
+/**
+ * Checks if the open book was written for a board variant.
+ *
+ * @param ai_rows The number of rows
+ * @param ai_cols The number of columns
+ * @param ai_winLength The number of marks in a row needed to win
+ * @return true if a book is open and matches the variant, false otherwise
+ */
+bool OpeningBook::isFor(const int ai_rows, const int ai_cols, const int ai_winLength) const {
+    return m_header && m_header->rows == ai_rows && m_header->cols == ai_cols && m_header->winLength == ai_winLength;
+}
+
+/**
+ * Looks up a canonical position with a binary search over the mapped entries.
+ *
+ * @param au_key The Zobrist hash of the canonical position
+ * @return The entry, or nullptr if the position is not in the book
+ */
+const OpeningBook::Entry* OpeningBook::find(const std::uint64_t au_key) const {
+    const Entry* l_end = m_entries + getEntryCount();
+    const Entry* l_entry = std::lower_bound(m_entries, l_end, au_key, [](const Entry& a_entry, const std::uint64_t au_value) { return a_entry.key < au_value; });
+    return l_entry != l_end && l_entry->key == au_key ? l_entry : nullptr;
+}
+
+/**
+ * Writes a book file. The entries are sorted by key and, if a key occurs more than once, only its first entry is kept.
+ *
+ * @param as_path The file to write
+ * @param ai_rows The number of rows of the board variant
+ * @param ai_cols The number of columns of the board variant
+ * @param ai_winLength The win length of the board variant
+ * @param a_entries The book positions
+ * @return true if the file was written completely, false otherwise
+ */
+bool OpeningBook::write(const std::string& as_path, const int ai_rows, const int ai_cols, const int ai_winLength, std::vector<Entry> a_entries) {
+    std::stable_sort(a_entries.begin(), a_entries.end(), [](const Entry& a, const Entry& b) { return a.key < b.key; });
+    a_entries.erase(std::unique(a_entries.begin(), a_entries.end(), [](const Entry& a, const Entry& b) { return a.key == b.key; }), a_entries.end());
+
+    Header l_header{};
+    std::memcpy(l_header.magic, MAGIC, sizeof(MAGIC));
+    l_header.version = FORMAT_VERSION;
+    l_header.byteOrderMark = BYTE_ORDER_MARK;
+    l_header.rows = static_cast<std::uint8_t>(ai_rows);
+    l_header.cols = static_cast<std::uint8_t>(ai_cols);
+    l_header.winLength = static_cast<std::uint8_t>(ai_winLength);
+    l_header.entryCount = a_entries.size();
+
+    std::ofstream l_file(as_path, std::ios::binary | std::ios::trunc);
+    l_file.write(reinterpret_cast<const char*>(&l_header), sizeof(l_header));
+    l_file.write(reinterpret_cast<const char*>(a_entries.data()), static_cast<std::streamsize>(a_entries.size() * sizeof(Entry)));
+    return static_cast<bool>(l_file);
+}
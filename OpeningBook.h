@@ -0,0 +1,79 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Precomputed best moves of one board variant, read from a file that is memory-mapped rather than parsed.
+// Positions are keyed by the Zobrist hash of their canonical form, so one entry covers every rotation and
+// reflection of a position, and the move is stored in the canonical orientation.
+//
+// File layout (native byte order, checked through a byte-order mark):
+//   Header  32 bytes: magic "TTTBOOK", format version, byte-order mark, rows, columns, win length, entry count
+//   Entries 16 bytes each, sorted by key, searched in place with a binary search
+// Opening a book only maps the file, so it takes microseconds whatever its size. The pages are mapped
+// read-only and shared, so every game process on the host uses the same copy in the page cache.
+class OpeningBook {
+public:
+    static constexpr std::uint32_t FORMAT_VERSION = 1;  // Bumped whenever the layout changes
+    static constexpr std::uint8_t SOLVED_DEPTH = 255;    // Depth of entries proven to the end of the game by the solver
+
+    // One book position, laid out exactly as in the file
+    struct Entry {
+        std::uint64_t key;        // Zobrist hash of the canonical position
+        std::int32_t value;       // Search value for the player to move, on AIPlayer's scale; +1, 0, -1 for solved entries
+        std::uint8_t move;        // Best move (1 to SIZE) in the canonical orientation
+        std::uint8_t depth;       // Depth the position was searched to
+        std::uint16_t reserved;   // Zero; keeps entries 16 bytes
+    };
+
+private:
+    // The file header, laid out exactly as in the file
+    struct Header {
+        char magic[8];                 // "TTTBOOK" followed by a zero byte
+        std::uint32_t version;         // FORMAT_VERSION of the writer
+        std::uint32_t byteOrderMark;   // BYTE_ORDER_MARK as the writer stored it
+        std::uint8_t rows;             // Board variant the book belongs to
+        std::uint8_t cols;
+        std::uint8_t winLength;
+        std::uint8_t reserved[5];      // Zero
+        std::uint64_t entryCount;      // Number of entries after the header
+    };
+
+    static_assert(sizeof(Entry) == 16, "Book entries must be 16 bytes");
+    static_assert(sizeof(Header) == 32, "The book header must be 32 bytes");
+
+    static constexpr char MAGIC[8] = {'T', 'T', 'T', 'B', 'O', 'O', 'K', '\0'};
+    static constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;  // Reads differently on a host of the other byte order
+
+    const void* m_mapping = nullptr;   // Start of the mapped file, null when no book is open
+    std::size_t m_mappingSize = 0;     // Length of the mapping in bytes
+    const Header* m_header = nullptr;  // The header, inside the mapping
+    const Entry* m_entries = nullptr;  // The sorted entries, inside the mapping
+#ifdef _WIN32
+    void* m_file = nullptr;            // Handle of the open file
+    void* m_mappingHandle = nullptr;   // Handle of the file mapping object
+#endif
+
+public:
+    // Constructors and destructors
+    OpeningBook() = default;   // Creates a closed book
+    ~OpeningBook();            // Unmaps the file
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    // Functions
+    bool open(const std::string& as_path);    // Map a book file, returns false if it is missing or invalid
+    void close();                             // Unmap the file
+    [[nodiscard]] bool isOpen() const { return m_mapping != nullptr; }
+    [[nodiscard]] bool isFor(int ai_rows, int ai_cols, int ai_winLength) const;  // Check if the book belongs to a board variant
+    [[nodiscard]] const Entry* find(std::uint64_t au_key) const;                 // Find the entry of a canonical position, or nullptr
+    [[nodiscard]] std::uint64_t getEntryCount() const { return m_header ? m_header->entryCount : 0; }
+
+    // Write a book file for a board variant; the entries are sorted first. Returns false if the file could not be written.
+    static bool write(const std::string& as_path, int ai_rows, int ai_cols, int ai_winLength, std::vector<Entry> a_entries);
+};
+
+#endif // OPENINGBOOK_H
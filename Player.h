@@ -6,18 +6,26 @@
 
 // Abstract base class representing a player (either human or AI) in the Tic-Tac-Toe game.
 // This class provides a common interface for different types of players, whether they are human or AI.
+// TBoard is the board variant the player plays on (e.g. Board3x3).
+template <typename TBoard>
 class Player {
 public:
     virtual ~Player() = default;  // Virtual destructor ensures proper cleanup of derived classes
 
     // Pure virtual function that must be implemented by derived classes to make a move
     // on the given board. This method defines how a player interacts with the board.
-    virtual bool makeMove(Board& a_board) = 0;
+    virtual bool makeMove(TBoard& a_board) = 0;
 
     // Virtual function to get the symbol (X or O) of the player.
     // This method is used to identify the player (X or O).
     [[nodiscard]] virtual CellState getSymbol() const = 0;
 
+    // Virtual functions to think on the opponent's time. startPondering is called with the position the
+    // opponent is about to move in and may start a background search; stopPondering is called once the
+    // opponent has moved and waits for that search to end. Players that do not ponder ignore both.
+    virtual void startPondering(const TBoard&) {}
+    virtual void stopPondering() {}
+
 protected:
     CellState m_player;  // The symbol representing this player (either X or O)
 
@@ -0,0 +1,385 @@
+#include "ProofSolver.h"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+constexpr char CHECKPOINT_MAGIC[8] = {'T', 'T', 'T', 'D', 'F', 'P', 'N', '\0'};  // Start of a checkpoint file
+constexpr std::uint32_t CHECKPOINT_VERSION = 1;                                   // Bumped when the layout changes
+
+// Header of a checkpoint file, followed by the buckets of both tables
+struct CheckpointHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint8_t rows;
+    std::uint8_t cols;
+    std::uint8_t winLength;
+    std::uint8_t reserved;
+    std::uint64_t bucketCount;  // Buckets per table; a checkpoint only resumes into tables of the same size
+    std::uint64_t nodes;        // Positions visited when the checkpoint was written
+};
+
+// Player to move, from the number of marks: X moves first
+template <typename TBoard>
+CellState sideToMove(const TBoard &a_board) {
+    return std::popcount(a_board.getMask(CellState::X)) == std::popcount(a_board.getMask(CellState::O)) ? CellState::X : CellState::O;
+}
+
+} // namespace
+
+/**
+ * Creates the two tables, each the largest power-of-two number of buckets fitting in half of au_megabytes.
+ * If a checkpoint path is given and the file there was written for the same board and table size, the
+ * tables are filled from it, so the proof continues from where the earlier run stopped.
+ *
+ * @param au_megabytes Memory for both tables together
+ * @param as_checkpointPath File to resume from and save progress to, empty for none
+ * @param au_checkpointInterval Positions to visit between two checkpoints
+ * @param au_nodeLimit Positions allowed per solve, 0 for no limit
+ */
+template <typename TBoard>
+ProofSolver<TBoard>::ProofSolver(const std::size_t au_megabytes, std::string as_checkpointPath,
+                                 const std::uint64_t au_checkpointInterval, const std::uint64_t au_nodeLimit)
+    : m_bucketCount(std::bit_floor(std::max<std::size_t>(au_megabytes * 1024 * 1024 / 2 / sizeof(Bucket), 1))),
+      m_questions{Question{false, nullptr}, Question{true, nullptr}}, m_checkpointPath(std::move(as_checkpointPath)),
+      m_checkpointInterval(std::max<std::uint64_t>(au_checkpointInterval, 1)),
+      m_nodeLimit(au_nodeLimit != 0 ? au_nodeLimit : UINT64_MAX) {
+    for (Question& l_question : m_questions) {
+        l_question.buckets = std::make_unique<Bucket[]>(m_bucketCount);
+    }
+    m_nextCheckpoint = m_checkpointInterval;
+    if (m_checkpointPath.empty()) {
+        return;
+    }
+
+    std::ifstream l_file(m_checkpointPath, std::ios::binary);
+    CheckpointHeader l_header{};
+    l_file.read(reinterpret_cast<char*>(&l_header), sizeof(l_header));
+    if (!l_file || std::memcmp(l_header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0 || l_header.version != CHECKPOINT_VERSION ||
+        l_header.rows != TBoard::ROWS || l_header.cols != TBoard::COLS || l_header.winLength != TBoard::WIN_LENGTH ||
+        l_header.bucketCount != m_bucketCount) {
+        return;  // Nothing to resume
+    }
+    for (Question& l_question : m_questions) {
+        l_file.read(reinterpret_cast<char*>(l_question.buckets.get()), static_cast<std::streamsize>(m_bucketCount * sizeof(Bucket)));
+    }
+    if (!l_file) {
+        for (Question& l_question : m_questions) {
+            l_question.buckets = std::make_unique<Bucket[]>(m_bucketCount);  // A truncated file is as good as none
+        }
+        return;
+    }
+    m_nodes = l_header.nodes;
+    m_nextCheckpoint = m_nodes + m_checkpointInterval;
+}
+
+/**
+ * Writes both tables to the checkpoint file. The file is written under a temporary name first and then
+ * renamed, so a run stopped in the middle of a save still leaves the previous checkpoint intact.
+ *
+ * @return true if the checkpoint was written, false if there is no checkpoint path or the write failed
+ */
+template <typename TBoard>
+bool ProofSolver<TBoard>::saveCheckpoint() const {
+    if (m_checkpointPath.empty()) {
+        return false;
+    }
+    CheckpointHeader l_header{};
+    std::memcpy(l_header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    l_header.version = CHECKPOINT_VERSION;
+    l_header.rows = TBoard::ROWS;
+    l_header.cols = TBoard::COLS;
+    l_header.winLength = TBoard::WIN_LENGTH;
+    l_header.bucketCount = m_bucketCount;
+    l_header.nodes = m_nodes;
+
+    const std::string ls_temporary = m_checkpointPath + ".tmp";
+    {
+        std::ofstream l_file(ls_temporary, std::ios::binary | std::ios::trunc);
+        l_file.write(reinterpret_cast<const char*>(&l_header), sizeof(l_header));
+        for (const Question& l_question : m_questions) {
+            l_file.write(reinterpret_cast<const char*>(l_question.buckets.get()), static_cast<std::streamsize>(m_bucketCount * sizeof(Bucket)));
+        }
+        if (!l_file) {
+            return false;
+        }
+    }
+    return std::rename(ls_temporary.c_str(), m_checkpointPath.c_str()) == 0;
+}
+
+/**
+ * Looks up the numbers stored for a position.
+ *
+ * @param a_question The question whose table is searched
+ * @param au_key The Zobrist hash of the position
+ * @return The entry, or nullptr if the table does not hold the position
+ */
+template <typename TBoard>
+const typename ProofSolver<TBoard>::TableEntry* ProofSolver<TBoard>::lookup(const Question& a_question, const std::uint64_t au_key) const {
+    const Bucket& l_bucket = a_question.buckets[au_key & (m_bucketCount - 1)];
+    for (const TableEntry& l_entry : l_bucket.entries) {
+        if (l_entry.key == au_key && (l_entry.phi != 0 || l_entry.delta != 0)) {
+            return &l_entry;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Saves the numbers of a position. An existing entry for the position is updated; otherwise an unused
+ * entry is taken, or else the one with the smallest subtree, which is the cheapest to compute again.
+ *
+ * @param a_question The question whose table is written
+ * @param au_key The Zobrist hash of the position
+ * @param au_phi The proof number for the player to move
+ * @param au_delta The disproof number for the player to move
+ * @param au_work The positions visited to reach these numbers
+ */
+template <typename TBoard>
+void ProofSolver<TBoard>::store(Question& a_question, const std::uint64_t au_key, const std::uint32_t au_phi,
+                                const std::uint32_t au_delta, const std::uint32_t au_work) {
+    Bucket& l_bucket = a_question.buckets[au_key & (m_bucketCount - 1)];
+    TableEntry* l_target = &l_bucket.entries[0];
+    for (TableEntry& l_entry : l_bucket.entries) {
+        if (l_entry.key == au_key || (l_entry.phi == 0 && l_entry.delta == 0)) {
+            l_target = &l_entry;
+            break;
+        }
+        if (l_entry.work < l_target->work) {
+            l_target = &l_entry;
+        }
+    }
+    const std::uint32_t lu_work = l_target->key == au_key ? std::max(l_target->work, au_work) : au_work;
+    *l_target = TableEntry{au_key, au_phi, au_delta, lu_work, 0};
+}
+
+/**
+ * Finds the numbers of the position after a move. A move that ends the game settles the position at once;
+ * otherwise the table is consulted, and a position it does not hold starts at one for both numbers.
+ *
+ * @param a_question The question being proved
+ * @param a_board The current position, taken through the move and back
+ * @param ai_move The move to look at
+ * @param au_phi Receives the proof number for the player to move after the move
+ * @param au_delta Receives the disproof number for that player
+ */
+template <typename TBoard>
+void ProofSolver<TBoard>::childNumbers(const Question& a_question, TBoard& a_board, const int ai_move,
+                                       std::uint32_t& au_phi, std::uint32_t& au_delta) const {
+    const CellState lc_mover = sideToMove(a_board);
+    const bool lb_won = a_board.pushMove(lc_mover, ai_move);
+    if (lb_won || a_board.checkDraw()) {
+        // X gets a yes on a win of its own, and on a draw when a draw is enough
+        const bool lb_yes = lb_won ? lc_mover == CellState::X : a_question.drawIsEnough;
+        const bool lb_nextIsX = lc_mover == CellState::O;
+        au_phi = lb_yes == lb_nextIsX ? 0 : INFINITE;
+        au_delta = lb_yes == lb_nextIsX ? INFINITE : 0;
+    } else if (const TableEntry* l_entry = lookup(a_question, a_board.getHash())) {
+        au_phi = l_entry->phi;
+        au_delta = l_entry->delta;
+    } else {
+        au_phi = 1;
+        au_delta = 1;
+    }
+    a_board.popMove();
+}
+
+/**
+ * The df-pn search of one position (Nagai's multiple iterative deepening). The proof number of the player
+ * to move is the smallest disproof number among the children, since one good move is enough, and the
+ * disproof number is the sum of the children's proof numbers, since every move has to fail. The child
+ * with the smallest disproof number is searched, with thresholds that return control here as soon as
+ * another child would become the better choice, until the position's numbers reach its own thresholds.
+ *
+ * @param a_question The question being proved
+ * @param a_board The position, not yet finished, taken through moves and back
+ * @param au_phiThreshold Return once the proof number reaches this
+ * @param au_deltaThreshold Return once the disproof number reaches this
+ * @return The positions visited
+ */
+template <typename TBoard>
+std::uint64_t ProofSolver<TBoard>::multipleIterativeDeepening(Question& a_question, TBoard& a_board,
+                                                              const std::uint32_t au_phiThreshold, const std::uint32_t au_deltaThreshold) {
+    std::uint64_t lu_work = 1;
+    ++m_nodes;
+    if (m_nodes >= m_nextCheckpoint) {
+        saveCheckpoint();
+        m_nextCheckpoint = m_nodes + m_checkpointInterval;
+    }
+
+    while (true) {
+        std::uint32_t lu_phi = INFINITE, lu_deltaSum = 0, lu_secondDelta = INFINITE, lu_bestPhi = 0;
+        bool lb_deltaInfinite = false;
+        int li_best = 0;
+        for (int i = 1; i <= TBoard::SIZE; ++i) {
+            if (!a_board.checkMove(i)) continue;
+            std::uint32_t lu_childPhi, lu_childDelta;
+            childNumbers(a_question, a_board, i, lu_childPhi, lu_childDelta);
+            lb_deltaInfinite = lb_deltaInfinite || lu_childPhi >= INFINITE;
+            lu_deltaSum = std::min(lu_deltaSum + lu_childPhi, INFINITE - 1);  // Both are below 2^30, so the sum cannot overflow
+            if (lu_childDelta < lu_phi) {
+                lu_secondDelta = lu_phi;
+                lu_phi = lu_childDelta;
+                lu_bestPhi = lu_childPhi;
+                li_best = i;
+            } else if (lu_childDelta < lu_secondDelta) {
+                lu_secondDelta = lu_childDelta;
+            }
+        }
+        const std::uint32_t lu_delta = lb_deltaInfinite ? INFINITE : lu_deltaSum;
+
+        if (lu_phi >= au_phiThreshold || lu_delta >= au_deltaThreshold || m_nodes >= m_stopNodes) {
+            store(a_question, a_board.getHash(), lu_phi, lu_delta, static_cast<std::uint32_t>(std::min<std::uint64_t>(lu_work, UINT32_MAX)));
+            return lu_work;
+        }
+
+        // Search the best child until it is no longer the best, or this position reaches a threshold
+        const std::int64_t li_childPhiThreshold = std::min<std::int64_t>(
+            static_cast<std::int64_t>(au_deltaThreshold) - lu_delta + lu_bestPhi, INFINITE);
+        const std::uint32_t lu_childDeltaThreshold = std::min(au_phiThreshold, lu_secondDelta + 1);
+        a_board.pushMove(sideToMove(a_board), li_best);
+        lu_work += multipleIterativeDeepening(a_question, a_board, static_cast<std::uint32_t>(li_childPhiThreshold), lu_childDeltaThreshold);
+        a_board.popMove();
+    }
+}
+
+/**
+ * Settles one question for a position that may already be finished.
+ *
+ * @param a_question The question to settle
+ * @param a_board The position, taken through moves and back
+ * @param ab_yes Receives the answer
+ * @return true if the question was settled, false if the node budget ran out first
+ */
+template <typename TBoard>
+bool ProofSolver<TBoard>::prove(Question& a_question, TBoard& a_board, bool& ab_yes) {
+    if (a_board.checkWin(CellState::X) || a_board.checkWin(CellState::O) || a_board.checkDraw()) {
+        ab_yes = a_board.checkWin(CellState::X) || (!a_board.checkWin(CellState::O) && a_question.drawIsEnough);
+        return true;
+    }
+    if (const TableEntry* l_entry = lookup(a_question, a_board.getHash()); !l_entry || (l_entry->phi != 0 && l_entry->delta != 0)) {
+        multipleIterativeDeepening(a_question, a_board, INFINITE, INFINITE);
+    }
+    const TableEntry* l_entry = lookup(a_question, a_board.getHash());
+    if (!l_entry || (l_entry->phi != 0 && l_entry->delta != 0)) {
+        return false;
+    }
+    ab_yes = (l_entry->phi == 0) == (sideToMove(a_board) == CellState::X);  // The player to move got their way, or did not
+    return true;
+}
+
+/**
+ * Combines the two questions into X's result: a win if X wins, otherwise a draw if X at least draws.
+ *
+ * @param a_board The position
+ * @param a_outcome Receives X's result
+ * @return true if the result is proven, false if the node budget ran out first
+ */
+template <typename TBoard>
+bool ProofSolver<TBoard>::valueForX(TBoard& a_board, Outcome& a_outcome) {
+    bool lb_wins = false, lb_draws = false;
+    if (!prove(m_questions[0], a_board, lb_wins)) return false;
+    if (!lb_wins && !prove(m_questions[1], a_board, lb_draws)) return false;
+    a_outcome = lb_wins ? Outcome::WIN : lb_draws ? Outcome::DRAW : Outcome::LOSS;
+    return true;
+}
+
+/**
+ * Picks the next move of a line of best play. Keeping X's result is one question with one answer:
+ * a won position stays won for X ("does X win?" stays yes), a lost one stays lost ("does X draw?" stays no),
+ * and in a drawn position X keeps the draw while O keeps X from winning. The table of that question
+ * usually settled the right child during the proof already; the player who gets their way takes the one
+ * that was cheapest to prove, the other player the one that held out longest. Only if the table lost the
+ * children is each one proved again.
+ *
+ * @param a_board The position, not yet finished
+ * @param ac_valueForX X's proven result in the position
+ * @return The move, or 0 if the node budget ran out
+ */
+template <typename TBoard>
+int ProofSolver<TBoard>::chooseMove(TBoard& a_board, const Outcome ac_valueForX) {
+    const CellState lc_mover = sideToMove(a_board);
+    const bool lb_winQuestion = ac_valueForX == Outcome::WIN || (ac_valueForX == Outcome::DRAW && lc_mover == CellState::O);
+    Question& l_question = m_questions[lb_winQuestion ? 0 : 1];
+    const bool lb_answer = ac_valueForX == Outcome::WIN || (ac_valueForX == Outcome::DRAW && lc_mover == CellState::X);
+    const bool lb_moverWantsAnswer = lb_answer == (lc_mover == CellState::X);
+    const bool lb_nextIsX = lc_mover == CellState::O;
+
+    int li_best = 0;
+    std::uint32_t lu_bestWork = 0;
+    for (int i = 1; i <= TBoard::SIZE; ++i) {
+        if (!a_board.checkMove(i)) continue;
+        std::uint32_t lu_phi, lu_delta;
+        childNumbers(l_question, a_board, i, lu_phi, lu_delta);
+        const bool lb_settled = lu_phi == 0 || lu_delta == 0;
+        if (!lb_settled || ((lu_phi == 0) == lb_nextIsX) != lb_answer) continue;
+
+        a_board.pushMove(lc_mover, i);
+        const TableEntry* l_entry = lookup(l_question, a_board.getHash());
+        const std::uint32_t lu_work = l_entry ? l_entry->work : 0;  // A move that ends the game needs no work at all
+        a_board.popMove();
+        if (li_best == 0 || (lb_moverWantsAnswer ? lu_work < lu_bestWork : lu_work > lu_bestWork)) {
+            li_best = i;
+            lu_bestWork = lu_work;
+        }
+    }
+    if (li_best != 0) {
+        return li_best;
+    }
+
+    for (int i = 1; i <= TBoard::SIZE; ++i) {
+        if (!a_board.checkMove(i)) continue;
+        bool lb_yes = false;
+        a_board.pushMove(lc_mover, i);
+        const bool lb_proven = prove(l_question, a_board, lb_yes);
+        a_board.popMove();
+        if (!lb_proven) return 0;
+        if (lb_yes == lb_answer) return i;
+    }
+    return 0;  // Unreachable once the position's own result is proven
+}
+
+/**
+ * Proves the value of a position and plays out a line of best play to the end of the game.
+ * The checkpoint, if any, is brought up to date when the proof is done.
+ *
+ * @param a_board The position to solve
+ * @return The value for the player to move and the line, or UNKNOWN if the node budget ran out
+ */
+template <typename TBoard>
+typename ProofSolver<TBoard>::Result ProofSolver<TBoard>::solve(const TBoard& a_board) {
+    Result l_result;
+    TBoard l_board = a_board;
+    m_stopNodes = m_nodeLimit == UINT64_MAX ? UINT64_MAX : m_nodes + m_nodeLimit;
+    Outcome lc_valueForX = Outcome::UNKNOWN;
+    if (!valueForX(l_board, lc_valueForX)) {
+        saveCheckpoint();
+        return l_result;
+    }
+
+    while (!l_board.checkWin(CellState::X) && !l_board.checkWin(CellState::O) && !l_board.checkDraw()) {
+        const int li_move = chooseMove(l_board, lc_valueForX);
+        if (li_move == 0) {
+            saveCheckpoint();
+            return l_result;
+        }
+        l_result.line.push_back(static_cast<std::uint8_t>(li_move));
+        l_board.pushMove(sideToMove(l_board), li_move);
+    }
+    saveCheckpoint();
+
+    const bool lb_xToMove = sideToMove(a_board) == CellState::X;
+    l_result.outcome = lc_valueForX == Outcome::DRAW ? Outcome::DRAW
+                     : (lc_valueForX == Outcome::WIN) == lb_xToMove ? Outcome::WIN
+                     : Outcome::LOSS;
+    return l_result;
+}
+
+// Explicit instantiations for the boards small enough to prove
+template class ProofSolver<Board3x3>;
+template class ProofSolver<Board4x4>;
+template class ProofSolver<Board5x5>;
+template class ProofSolver<Board6x6>;
@@ -0,0 +1,106 @@
+#ifndef PROOFSOLVER_H
+#define PROOFSOLVER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Board.h"
+
+// Proves the value of a position with depth-first proof-number search (df-pn), for boards too large for the
+// full-width minimax of AIPlayer to finish. Proof-number search always expands the part of the tree that is
+// closest to settling the question, so it proves wins and draws while visiting a small part of the game tree.
+//
+// df-pn answers yes/no questions, so the value is settled by two of them, both from X's side: "does X win?"
+// and "does X at least draw?". Each question has its own transposition table holding the proof and disproof
+// numbers of the positions it has seen; the tables have a fixed size, and when a bucket is full the entry with
+// the smallest subtree is replaced. Both tables can be written to a checkpoint file from time to time and read
+// back, so a long proof survives being stopped and resumes where it left off.
+template <typename TBoard>
+class ProofSolver {
+public:
+    // Proven value of a position for the player to move
+    enum class Outcome : std::uint8_t {
+        UNKNOWN,  // The node budget ran out first
+        WIN,
+        DRAW,
+        LOSS
+    };
+
+    // The answer of solve: the value, and a line of best play from the position to the end of the game
+    struct Result {
+        Outcome outcome = Outcome::UNKNOWN;
+        std::vector<std::uint8_t> line;  // Moves (1 to SIZE), starting with the player to move; empty if unknown
+    };
+
+private:
+    static constexpr std::uint32_t INFINITE = 1u << 30;  // Proof or disproof number of a settled position
+    static constexpr std::size_t BUCKET_SIZE = 4;        // Entries per table bucket
+
+    // Proof and disproof numbers of one position, seen from the player to move: phi is the proof number if
+    // the position is a yes for that player, delta the one for a no, so both kinds of node use the same code.
+    // A settled position has one of the two at INFINITE, so an entry with both at 0 is unused.
+    struct TableEntry {
+        std::uint64_t key = 0;     // Zobrist hash of the position
+        std::uint32_t phi = 0;     // Effort to prove the player to move gets their way
+        std::uint32_t delta = 0;   // Effort to prove they do not
+        std::uint32_t work = 0;    // Positions visited below this one, which decides what gets replaced
+        std::uint32_t reserved = 0;
+    };
+
+    struct Bucket {
+        TableEntry entries[BUCKET_SIZE];
+    };
+
+    // One yes/no question with its own table
+    struct Question {
+        bool drawIsEnough;                 // "Does X at least draw?" rather than "does X win?"
+        std::unique_ptr<Bucket[]> buckets;
+    };
+
+    std::size_t m_bucketCount;                     // Buckets per table, a power of two
+    std::array<Question, 2> m_questions;           // 0: does X win, 1: does X at least draw
+    std::string m_checkpointPath;                  // Where to save progress, empty for no checkpoints
+    std::uint64_t m_checkpointInterval;            // Positions visited between checkpoints
+    std::uint64_t m_nodeLimit;                     // Positions allowed per solve, UINT64_MAX for no limit
+    std::uint64_t m_nodes = 0;                     // Positions visited since the solver was created or resumed
+    std::uint64_t m_stopNodes = UINT64_MAX;        // Node count at which the current solve gives up
+    std::uint64_t m_nextCheckpoint = 0;            // Node count at which the next checkpoint is written
+
+    // Function to find the stored numbers of a position, or nullptr if the table does not hold it
+    [[nodiscard]] const TableEntry* lookup(const Question& a_question, std::uint64_t au_key) const;
+
+    // Function to save the numbers of a position, replacing the entry with the smallest subtree when the bucket is full
+    void store(Question& a_question, std::uint64_t au_key, std::uint32_t au_phi, std::uint32_t au_delta, std::uint32_t au_work);
+
+    // Function to get the numbers of the position after a move, seen from the player who then moves
+    void childNumbers(const Question& a_question, TBoard& a_board, int ai_move, std::uint32_t& au_phi, std::uint32_t& au_delta) const;
+
+    // Function to search a position until its numbers reach the thresholds, returns the positions visited
+    std::uint64_t multipleIterativeDeepening(Question& a_question, TBoard& a_board, std::uint32_t au_phiThreshold, std::uint32_t au_deltaThreshold);
+
+    // Function to settle one question for a position, returns false if the node budget ran out
+    bool prove(Question& a_question, TBoard& a_board, bool& ab_yes);
+
+    // Function to get X's result in a position from the two questions
+    bool valueForX(TBoard& a_board, Outcome& a_outcome);
+
+    // Function to pick a move that keeps X's result, for the line of best play; returns 0 if the node budget ran out
+    int chooseMove(TBoard& a_board, Outcome ac_valueForX);
+
+public:
+    // Constructors and destructors
+    // Creates a solver with two tables sharing au_megabytes; with a checkpoint path, earlier progress saved there is resumed
+    explicit ProofSolver(std::size_t au_megabytes, std::string as_checkpointPath = {},
+                         std::uint64_t au_checkpointInterval = 50'000'000, std::uint64_t au_nodeLimit = 0);
+    ~ProofSolver() = default;  // Default destructor
+
+    // Functions
+    Result solve(const TBoard& a_board);                              // Prove the value of a position and find a line of best play
+    bool saveCheckpoint() const;                                      // Write both tables to the checkpoint file, false on failure
+    [[nodiscard]] std::uint64_t getNodeCount() const { return m_nodes; }  // Get the positions visited so far
+};
+
+#endif // PROOFSOLVER_H
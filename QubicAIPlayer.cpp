@@ -0,0 +1,233 @@
+#include "QubicAIPlayer.h"
+#include <algorithm>
+#include <bit>
+#include <iostream>
+
+namespace {
+
+constexpr int WIN_SCORE = 100000;         // Winning the game; faster wins score higher
+constexpr int INFINITY_SCORE = 1000000;   // Bound larger than any score
+constexpr int WIN_THRESHOLD = WIN_SCORE - QubicBoard::SIZE;  // Scores beyond this are wins or losses, stored relative to their position
+
+// Value of an unblocked line holding 0, 1, 2, or 3 of a player's marks
+constexpr int LINE_WEIGHTS[4] = {0, 1, 8, 64};
+constexpr int DOUBLE_THREAT_SCORE = 5000; // Two open threats at once cannot both be blocked
+
+/**
+ * Orders the cells for move generation: cells on 7 lines (the corners and the inner cube) first,
+ * then the cells on 4 lines, each group by increasing move number.
+ */
+constexpr std::array<std::uint8_t, QubicBoard::SIZE> makeMoveOrder() {
+    std::array<std::uint8_t, QubicBoard::SIZE> l_order{};
+    int li_count = 0;
+    for (const int li_lines : {qubic_detail::MAX_CELL_LINES, 4}) {
+        for (int cell = 0; cell < QubicBoard::SIZE; ++cell) {
+            if (QubicBoard::CELL_LINES[cell].count == li_lines) {
+                l_order[li_count++] = static_cast<std::uint8_t>(cell + 1);
+            }
+        }
+    }
+    return l_order;
+}
+
+constexpr auto MOVE_ORDER = makeMoveOrder();
+
+/**
+ * Scores the lines still open to one player, weighted by how many marks they already hold.
+ */
+int scorePlayer(const QubicBoard &a_board, const CellState ac_player) {
+    const QubicBoard::Mask lu_own = a_board.getMask(ac_player);
+    const QubicBoard::Mask lu_theirs = a_board.getMask(opponentOf(ac_player));
+    int li_score = 0;
+    for (const QubicBoard::Mask lu_line : QubicBoard::LINE_MASKS) {
+        if ((lu_line & lu_theirs) == 0) {
+            li_score += LINE_WEIGHTS[std::popcount(lu_line & lu_own) & 3];
+        }
+    }
+    return li_score;
+}
+
+} // namespace
+
+// Constructor that sets the player's symbol and budget and allocates the transposition table
+QubicAIPlayer::QubicAIPlayer(const CellState ac_player, const SearchOptions& a_options)
+    : Player(ac_player), m_budget(a_options.moveTime), m_nodeLimit(a_options.nodeLimit != 0 ? a_options.nodeLimit : UINT64_MAX),
+      m_table(a_options.tableMegabytes) {}
+
+/**
+ * Evaluates a position that is not over yet.
+ * The player to move wins at once if they hold a threat, so only the opponent's threats are counted here:
+ * two or more of them cannot all be blocked.
+ *
+ * @param a_board The current game board
+ * @return A heuristic score, positive when the player to move stands better
+ */
+int QubicAIPlayer::evaluateBoard(const QubicBoard &a_board) const {
+    const CellState lc_toMove = a_board.getSideToMove();
+    const CellState lc_opponent = opponentOf(lc_toMove);
+    int li_score = scorePlayer(a_board, lc_toMove) - scorePlayer(a_board, lc_opponent);
+    if (std::popcount(a_board.getThreats(lc_opponent)) >= 2) {
+        li_score -= DOUBLE_THREAT_SCORE;
+    }
+    return li_score;
+}
+
+/**
+ * Lists the moves to search. A winning cell is the only move worth trying, and an opponent's threat
+ * must be blocked, so in both cases the list shrinks to those cells. Otherwise every free cell is listed,
+ * the best move from the transposition table first, then the cells on the most lines.
+ *
+ * @param a_board The current game board
+ * @param a_moves Receives the moves (1-64) in search order
+ * @param ai_firstMove A move to try first, or 0
+ * @return The number of moves written to a_moves
+ */
+int QubicAIPlayer::generateMoves(const QubicBoard &a_board, std::array<std::uint8_t, QubicBoard::SIZE> &a_moves, const int ai_firstMove) const {
+    const CellState lc_toMove = a_board.getSideToMove();
+    const QubicBoard::Mask lu_free = a_board.getMask(CellState::EMPTY);
+    QubicBoard::Mask lu_candidates = a_board.getThreats(lc_toMove) & lu_free;
+    if (lu_candidates != 0) {
+        a_moves[0] = static_cast<std::uint8_t>(std::countr_zero(lu_candidates) + 1);  // Win at once
+        return 1;
+    }
+    lu_candidates = a_board.getThreats(opponentOf(lc_toMove)) & lu_free;
+    if (lu_candidates == 0) {
+        lu_candidates = lu_free;
+    }
+
+    int li_count = 0;
+    if (ai_firstMove != 0 && ((lu_candidates >> (ai_firstMove - 1)) & 1u)) {
+        a_moves[li_count++] = static_cast<std::uint8_t>(ai_firstMove);
+    }
+    for (const std::uint8_t lu_move : MOVE_ORDER) {
+        if (((lu_candidates >> (lu_move - 1)) & 1u) && lu_move != ai_firstMove) {
+            a_moves[li_count++] = lu_move;
+        }
+    }
+    return li_count;
+}
+
+/**
+ * Negamax search with alpha-beta pruning and a transposition table.
+ * The search gives up as soon as the time or node budget runs out; the caller then discards the unfinished iteration.
+ *
+ * @param a_board The current game board
+ * @param ai_depth The remaining depth to search
+ * @param ai_ply The distance from the root, used to prefer faster wins
+ * @param ai_alpha The lower bound of the search window
+ * @param ai_beta The upper bound of the search window
+ * @return The value of the position for the player to move
+ */
+int QubicAIPlayer::negamax(QubicBoard &a_board, const int ai_depth, const int ai_ply, int ai_alpha, const int ai_beta) {
+    if (++m_nodes >= m_nodeLimit || ((m_nodes & 1023) == 0 && std::chrono::steady_clock::now() >= m_deadline)) {
+        m_aborted = true;  // Out of budget, unwind without trusting the result
+    }
+    if (m_aborted) return 0;
+
+    if (a_board.checkWin(opponentOf(a_board.getSideToMove()))) return -WIN_SCORE + ai_ply;  // The previous move won
+    if (a_board.checkDraw()) return 0;
+    if (ai_depth == 0) return evaluateBoard(a_board);
+
+    // Use a stored result if it was searched deep enough, otherwise just try its best move first
+    const int li_alphaIn = ai_alpha;
+    int li_firstMove = 0;
+    if (TranspositionTable::Entry l_entry; m_table.probe(a_board.getHash(), l_entry)) {
+        li_firstMove = l_entry.move;
+        if (l_entry.depth >= ai_depth) {
+            const int li_value = TranspositionTable::fromTableScore(l_entry.value, ai_ply, WIN_THRESHOLD);
+            if (l_entry.bound == TranspositionTable::Bound::EXACT) return li_value;
+            if (l_entry.bound == TranspositionTable::Bound::LOWER && li_value >= ai_beta) return li_value;
+            if (l_entry.bound == TranspositionTable::Bound::UPPER && li_value <= ai_alpha) return li_value;
+        }
+    }
+
+    std::array<std::uint8_t, QubicBoard::SIZE> l_moves{};
+    const int li_count = generateMoves(a_board, l_moves, li_firstMove);
+
+    // Forced replies do not use up depth, so threat sequences are followed to the end
+    const int li_childDepth = li_count == 1 ? ai_depth : ai_depth - 1;
+
+    const CellState lc_toMove = a_board.getSideToMove();
+    int li_best = -INFINITY_SCORE;
+    int li_bestMove = l_moves[0];
+    for (int i = 0; i < li_count; ++i) {
+        a_board.pushMove(lc_toMove, l_moves[i]);
+        const int li_value = -negamax(a_board, li_childDepth, ai_ply + 1, -ai_beta, -ai_alpha);
+        a_board.popMove();
+        if (m_aborted) return 0;
+
+        if (li_value > li_best) {
+            li_best = li_value;
+            li_bestMove = l_moves[i];
+        }
+        ai_alpha = std::max(ai_alpha, li_value);
+        if (ai_alpha >= ai_beta) break;  // The opponent will avoid this position
+    }
+
+    const TranspositionTable::Bound lc_bound = li_best <= li_alphaIn ? TranspositionTable::Bound::UPPER
+                                             : li_best >= ai_beta ? TranspositionTable::Bound::LOWER
+                                             : TranspositionTable::Bound::EXACT;
+    m_table.store(a_board.getHash(), TranspositionTable::toTableScore(li_best, ai_ply, WIN_THRESHOLD), lc_bound, ai_depth, li_bestMove);
+    return li_best;
+}
+
+/**
+ * Finds the best move within the time budget using iterative deepening.
+ * Each iteration searches one ply deeper, starting from the previous best move; when the deadline
+ * interrupts an iteration, the move from the last completed one is returned.
+ *
+ * @param a_board The current game board
+ * @return The chosen move (1-64)
+ */
+int QubicAIPlayer::findBestMove(QubicBoard &a_board) {
+    m_deadline = std::chrono::steady_clock::now() + m_budget;
+    m_nodes = 0;
+    m_aborted = false;
+    m_table.newSearch();
+
+    std::array<std::uint8_t, QubicBoard::SIZE> l_moves{};
+    const int li_count = generateMoves(a_board, l_moves, 0);
+    int li_bestMove = l_moves[0];  // Always have a legal answer, even if the first iteration is cut short
+    if (li_count == 1) {
+        return li_bestMove;  // A win or a forced block, nothing to search
+    }
+
+    for (int depth = 1; depth <= QubicBoard::SIZE - a_board.getMoveCount(); ++depth) {
+        int li_alpha = -INFINITY_SCORE;
+        int li_iterationMove = li_bestMove;
+
+        // Search the previous best move first so a good bound is available early
+        std::stable_partition(l_moves.begin(), l_moves.begin() + li_count, [li_bestMove](const std::uint8_t move) { return move == li_bestMove; });
+        for (int i = 0; i < li_count; ++i) {
+            a_board.pushMove(m_player, l_moves[i]);
+            const int li_value = -negamax(a_board, depth - 1, 1, -INFINITY_SCORE, -li_alpha);
+            a_board.popMove();
+            if (m_aborted) break;
+            if (li_value > li_alpha) {
+                li_alpha = li_value;
+                li_iterationMove = l_moves[i];
+            }
+        }
+
+        if (m_aborted) break;                         // Keep the move from the last completed iteration
+        li_bestMove = li_iterationMove;
+        if (li_alpha >= WIN_THRESHOLD || li_alpha <= -WIN_THRESHOLD) {
+            break;  // The result is proven, no need to look deeper
+        }
+    }
+    return li_bestMove;
+}
+
+/**
+ * Makes the best move the AI finds within its time budget.
+ *
+ * @param a_board The board where the AI will make its move
+ * @return true if the AI successfully made a move, false otherwise
+ */
+bool QubicAIPlayer::makeMove(QubicBoard &a_board) {
+    const int li_bestMove = findBestMove(a_board);  // Get the best move
+
+    a_board.pushMove(m_player, li_bestMove);
+    std::cout << "AI makes a move at position: " << li_bestMove << std::endl;
+    return true;  // Return true to indicate the move was successful
+}
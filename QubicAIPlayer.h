@@ -0,0 +1,48 @@
+#ifndef QUBICAIPLAYER_H
+#define QUBICAIPLAYER_H
+
+#include <chrono>
+#include <cstdint>
+#include "Player.h"
+#include "SearchOptions.h"
+#include "TranspositionTable.h"
+#include "QubicBoard.h"
+
+// Class representing an AI player for Qubic.
+// With 64 cells the game tree is far too large for a full minimax, so the AI runs an iterative-deepening
+// alpha-beta search with a transposition table and a line-based evaluation, and answers with the best move
+// of the last completed iteration once its time budget runs out.
+// Threats are resolved before searching: a winning cell is always taken and an opponent's threat is always blocked.
+class QubicAIPlayer final : public Player<QubicBoard> {
+public:
+    // Constructor initializes the AI player's symbol, its transposition table, and its time and node budget per move
+    explicit QubicAIPlayer(CellState ac_player, const SearchOptions& a_options = {});
+
+    // Override the makeMove method to allow the AI player to make a move
+    bool makeMove(QubicBoard &a_board) override;
+
+    // Override the getSymbol method to return the AI player's symbol (X or O)
+    [[nodiscard]] CellState getSymbol() const override { return m_player; }
+
+    // Function to find the best move that can be found within the time budget
+    int findBestMove(QubicBoard &a_board);
+
+private:
+    std::chrono::milliseconds m_budget;                       // Thinking time per move
+    std::uint64_t m_nodeLimit;                                // Nodes allowed per move
+    std::chrono::steady_clock::time_point m_deadline;         // When the current search has to stop
+    TranspositionTable m_table;                               // Results of positions already searched
+    std::uint64_t m_nodes = 0;                                // Nodes visited by the current search
+    bool m_aborted = false;                                   // Set when the budget interrupted an iteration
+
+    // Function to evaluate a non-terminal position from the point of view of the player to move
+    [[nodiscard]] int evaluateBoard(const QubicBoard &a_board) const;
+
+    // Function to list the moves worth searching, in the order they should be tried
+    int generateMoves(const QubicBoard &a_board, std::array<std::uint8_t, QubicBoard::SIZE> &a_moves, int ai_firstMove) const;
+
+    // Recursive negamax search with alpha-beta pruning, returns the value for the player to move
+    int negamax(QubicBoard &a_board, int ai_depth, int ai_ply, int ai_alpha, int ai_beta);
+};
+
+#endif // QUBICAIPLAYER_H
@@ -0,0 +1,144 @@
+#include "QubicBoard.h"
+#include <bit>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * Prints the four layers of the cube side by side, from the bottom layer (moves 1-16) to the top (49-64).
+ * Empty cells show their move number, occupied cells show X or O.
+ */
+void QubicBoard::printBoard() const {
+    for (int layer = 0; layer < 4; ++layer) {
+        std::cout << " Layer " << (layer + 1) << (layer < 3 ? "        " : "\n");
+    }
+    for (int row = 0; row < 4; ++row) {
+        for (int layer = 0; layer < 4; ++layer) {
+            for (int col = 0; col < 4; ++col) {
+                const int li_index = layer * 16 + row * 4 + col;
+                const Mask lu_bit = Mask{1} << li_index;
+                if (m_xMask & lu_bit) {
+                    std::cout << std::setw(3) << CellState::X;
+                } else if (m_oMask & lu_bit) {
+                    std::cout << std::setw(3) << CellState::O;
+                } else {
+                    std::cout << std::setw(3) << (li_index + 1);  // Move number of the empty cell
+                }
+            }
+            std::cout << (layer < 3 ? "   |" : "\n");  // Separator between layers
+        }
+    }
+}
+
+/**
+ * Prints all available (empty) cells of the cube with their move numbers.
+ */
+void QubicBoard::printAvailableMoves() const {
+    std::cout << "Available moves: ";
+    for (Mask lu_free = getMask(CellState::EMPTY); lu_free != 0; lu_free &= lu_free - 1) {
+        std::cout << "(" << (std::countr_zero(lu_free) + 1) << ") ";
+    }
+    std::cout << "\n";
+}
+
+/**
+ * Plays a move and records it, so it can be taken back with popMove.
+ * Only the lines through the cell can be completed, so at most 7 masks are tested.
+ *
+ * @param ac_player The player making the move (either X or O)
+ * @param ai_move The move number (1-64) of an empty cell
+ * @return true if the move completed a line, false otherwise
+ */
+bool QubicBoard::pushMove(const CellState ac_player, const int ai_move) {
+    const int li_index = ai_move - 1;
+    const int li_playerIndex = ac_player == CellState::X ? 0 : 1;
+    Mask& lu_mask = li_playerIndex == 0 ? m_xMask : m_oMask;
+    lu_mask |= Mask{1} << li_index;
+    m_hash ^= ZOBRIST_KEYS[li_index][li_playerIndex];
+
+    bool lb_won = false;
+    const auto& l_cellLines = CELL_LINES[li_index];
+    for (int i = 0; i < l_cellLines.count && !lb_won; ++i) {
+        const Mask lu_line = LINE_MASKS[l_cellLines.lines[i]];
+        lb_won = (lu_mask & lu_line) == lu_line;
+    }
+    m_wins[li_playerIndex] += lb_won ? 1 : 0;
+
+    m_history[m_moveCount] = static_cast<std::uint8_t>(ai_move);
+    m_wonByMove[m_moveCount] = lb_won;
+    ++m_moveCount;
+    return lb_won;
+}
+
+/**
+ * Takes back the most recent move recorded by pushMove.
+ *
+ * @return The move number (1-64) that was taken back
+ */
+int QubicBoard::popMove() {
+    --m_moveCount;
+    const int li_move = m_history[m_moveCount];
+    const Mask lu_bit = Mask{1} << (li_move - 1);
+    const int li_playerIndex = (m_xMask & lu_bit) ? 0 : 1;
+    (li_playerIndex == 0 ? m_xMask : m_oMask) &= ~lu_bit;
+    m_hash ^= ZOBRIST_KEYS[li_move - 1][li_playerIndex];
+    m_wins[li_playerIndex] -= m_wonByMove[m_moveCount] ? 1 : 0;
+    return li_move;
+}
+
+/**
+ * Checks if a player has won the game, i.e. one of their moves completed a line.
+ *
+ * @param ac_player The player to check (either X or O)
+ * @return true if the player has won, false otherwise
+ */
+bool QubicBoard::checkWin(const CellState ac_player) const {
+    if (ac_player == CellState::EMPTY) return false;
+    return m_wins[ac_player == CellState::X ? 0 : 1] > 0;
+}
+
+/**
+ * Checks if the cube is full. Wins are checked first by the game, so a full cube is a draw.
+ *
+ * @return true if every cell is occupied, false otherwise
+ */
+bool QubicBoard::checkDraw() const {
+    return (m_xMask | m_oMask) == ~Mask{0};
+}
+
+/**
+ * Checks if a move is valid: the move number must be in range and the cell empty.
+ *
+ * @param ai_move The move number (1-64) to check
+ * @return true if the move is valid, false otherwise
+ */
+bool QubicBoard::checkMove(const int ai_move) const {
+    return ai_move >= 1 && ai_move <= SIZE && (((m_xMask | m_oMask) >> (ai_move - 1)) & 1u) == 0;
+}
+
+/**
+ * Finds the threats of a player: free cells that would complete one of their lines,
+ * i.e. lines holding three of their marks and none of the opponent's.
+ *
+ * @param ac_player The player to check (either X or O)
+ * @return A mask of the threatened cells; two or more bits usually means the opponent cannot stop them
+ */
+QubicBoard::Mask QubicBoard::getThreats(const CellState ac_player) const {
+    const Mask lu_own = getMask(ac_player);
+    const Mask lu_theirs = getMask(opponentOf(ac_player));
+    Mask lu_threats = 0;
+    for (const Mask lu_line : LINE_MASKS) {
+        if ((lu_line & lu_theirs) == 0 && std::popcount(lu_line & lu_own) == 3) {
+            lu_threats |= lu_line & ~lu_own;
+        }
+    }
+    return lu_threats;
+}
+
+/**
+ * Determines whose turn it is. X moves first and the players alternate.
+ *
+ * @return X after an even number of moves, O after an odd number
+ */
+CellState QubicBoard::getSideToMove() const {
+    return m_moveCount % 2 == 0 ? CellState::X : CellState::O;
+}
@@ -0,0 +1,141 @@
+#ifndef QUBICBOARD_H
+#define QUBICBOARD_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include "Board.h"
+#include "CellState.h"
+
+namespace qubic_detail {
+
+inline constexpr int LINE_COUNT = 76;  // Winning lines of the 4x4x4 cube
+
+/**
+ * Generates the 76 winning lines of the cube at compile time: rows, columns, and pillars,
+ * the diagonals of every plane, and the four space diagonals.
+ * Cell (layer, row, col) is bit layer * 16 + row * 4 + col.
+ *
+ * @return An array with one 64-bit mask per line
+ */
+constexpr std::array<std::uint64_t, LINE_COUNT> makeLineMasks() {
+    std::array<std::uint64_t, LINE_COUNT> l_masks{};
+    int li_line = 0;
+    for (int dl = -1; dl <= 1; ++dl) {
+        for (int dr = -1; dr <= 1; ++dr) {
+            for (int dc = -1; dc <= 1; ++dc) {
+                // Keep one of each pair of opposite directions: the first non-zero step must be positive
+                const int li_first = dl != 0 ? dl : (dr != 0 ? dr : dc);
+                if (li_first <= 0) {
+                    continue;
+                }
+                for (int layer = 0; layer < 4; ++layer) {
+                    for (int row = 0; row < 4; ++row) {
+                        for (int col = 0; col < 4; ++col) {
+                            const int li_endLayer = layer + 3 * dl, li_endRow = row + 3 * dr, li_endCol = col + 3 * dc;
+                            if (li_endLayer < 0 || li_endLayer > 3 || li_endRow < 0 || li_endRow > 3 || li_endCol < 0 || li_endCol > 3) {
+                                continue;  // The line would leave the cube
+                            }
+                            std::uint64_t lu_mask = 0;
+                            for (int step = 0; step < 4; ++step) {
+                                lu_mask |= std::uint64_t{1} << ((layer + step * dl) * 16 + (row + step * dr) * 4 + col + step * dc);
+                            }
+                            l_masks[li_line++] = lu_mask;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return l_masks;
+}
+
+inline constexpr int MAX_CELL_LINES = 7;  // Corners and the 8 inner cells lie on 7 lines, every other cell on 4
+
+// Indices of the win lines passing through one cell
+struct CellLines {
+    std::array<std::uint8_t, MAX_CELL_LINES> lines{};  // Line indices into LINE_MASKS
+    int count = 0;                                      // Number of valid entries in lines
+};
+
+// Inverts the line masks into a per-cell table of the lines through each cell
+constexpr std::array<CellLines, 64> makeCellLines(const std::array<std::uint64_t, LINE_COUNT>& a_masks) {
+    std::array<CellLines, 64> l_cells{};
+    for (int line = 0; line < LINE_COUNT; ++line) {
+        for (int cell = 0; cell < 64; ++cell) {
+            if ((a_masks[line] >> cell) & 1u) {
+                l_cells[cell].lines[l_cells[cell].count++] = static_cast<std::uint8_t>(line);
+            }
+        }
+    }
+    return l_cells;
+}
+
+} // namespace qubic_detail
+
+static_assert(qubic_detail::makeLineMasks()[qubic_detail::LINE_COUNT - 1] != 0, "The cube must have exactly 76 winning lines");
+
+// Class representing a Qubic board: a 4x4x4 cube where four marks in a row along any of its 76 lines win.
+// Each player's marks fit exactly in a uint64_t, so win checks, threat detection, and move generation
+// are all 64-bit mask operations.
+// Moves are numbered 1-64: move = layer * 16 + row * 4 + col + 1.
+class QubicBoard {
+public:
+    static constexpr int SIZE = 64;              // Total number of cells in the cube
+    static constexpr int LINE_COUNT = qubic_detail::LINE_COUNT;
+
+    static constexpr const char* VARIANT_NAME = "Qubic (4x4x4, four in a row)";  // Shown in the game header
+
+    using Mask = std::uint64_t;                  // One bit per cell, bit (i - 1) corresponds to move i
+
+    static constexpr auto LINE_MASKS = qubic_detail::makeLineMasks();  // All winning lines as cell masks
+
+    // For every cell, the win lines that pass through it
+    static constexpr auto CELL_LINES = qubic_detail::makeCellLines(LINE_MASKS);
+
+    // Zobrist keys for every (cell, player) pair
+    static constexpr auto ZOBRIST_KEYS = board_detail::makeZobristKeys<SIZE>();
+
+private:
+    Mask m_xMask = 0;                            // Cells occupied by player X
+    Mask m_oMask = 0;                            // Cells occupied by player O
+    std::uint64_t m_hash = 0;                    // Zobrist hash of the position
+    std::array<int, 2> m_wins{};                 // Per-player number of recorded moves that completed a line
+    std::array<std::uint8_t, SIZE> m_history{};  // Moves (1-64) played through pushMove, oldest first
+    std::array<bool, SIZE> m_wonByMove{};        // Whether each recorded move completed a line
+    int m_moveCount = 0;                         // Number of valid entries in m_history
+
+public:
+    // Constructors and destructors
+    QubicBoard() = default;   // Constructor to initialize an empty cube
+    ~QubicBoard() = default;  // Default destructor
+
+    // Functions
+    void printBoard() const;                                          // Method to print the four layers of the cube
+    void printAvailableMoves() const;                                 // Method to print the available moves
+    bool pushMove(CellState ac_player, int ai_move);                  // Play a move and record it, returns true if it wins
+    int popMove();                                                    // Take back the last recorded move, returns its move number
+    [[nodiscard]] bool checkWin(CellState ac_player) const;           // Method to check if a player has won
+    [[nodiscard]] bool checkDraw() const;                             // Method to check if the cube is full
+    [[nodiscard]] bool checkMove(int ai_move) const;                  // Method to check if a move is valid
+
+    [[nodiscard]] Mask getMask(CellState ac_player) const;            // Get the cells of a player (EMPTY: the free cells)
+    [[nodiscard]] Mask getThreats(CellState ac_player) const;         // Get the free cells that would complete a line for a player
+    [[nodiscard]] CellState getSideToMove() const;                    // X on an empty cube, then alternating
+    [[nodiscard]] int getMoveCount() const { return m_moveCount; }
+    [[nodiscard]] std::uint64_t getHash() const { return m_hash; }
+};
+
+/**
+ * Returns the cells of a player.
+ *
+ * @param ac_player The player to query (X or O), or EMPTY for the free cells
+ * @return A 64-bit mask with bit (move - 1) set for every matching cell
+ */
+inline QubicBoard::Mask QubicBoard::getMask(const CellState ac_player) const {
+    if (ac_player == CellState::X) return m_xMask;
+    if (ac_player == CellState::O) return m_oMask;
+    return ~(m_xMask | m_oMask);
+}
+
+#endif // QUBICBOARD_H
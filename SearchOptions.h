@@ -0,0 +1,28 @@
+#ifndef SEARCHOPTIONS_H
+#define SEARCHOPTIONS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class OpeningBook;
+class Tablebase4x4;
+
+// Settings shared by every AI player, chosen once at startup and passed down through Game.
+struct SearchOptions {
+    static constexpr std::size_t DEFAULT_TABLE_MEGABYTES = 16;               // Transposition table size when none is given
+    static constexpr std::chrono::milliseconds DEFAULT_MOVE_TIME{1000};      // Thinking time per move when none is given
+
+    std::size_t tableMegabytes = DEFAULT_TABLE_MEGABYTES;                    // Memory for each AI player's transposition table
+    std::chrono::milliseconds moveTime = DEFAULT_MOVE_TIME;                  // Wall-clock budget for each AI move
+    std::uint64_t nodeLimit = 0;                                             // Search nodes allowed per AI move, 0 for no limit
+    int maxDepth = 0;                                                        // Deepest search iteration, 0 for no limit
+    int threads = 1;                                                         // Search threads per AI player
+    bool lazySmp = false;                                                    // Share the threads by Lazy SMP instead of splitting the root moves
+    bool logStats = false;                                                   // Print the statistics of every AI search to std::clog
+    std::shared_ptr<const Tablebase4x4> tablebase4x4;                        // Solved 4x4 positions, answered without searching when set
+    std::shared_ptr<const OpeningBook> book;                                 // Memory-mapped book, used on the board variant it was built for
+};
+
+#endif // SEARCHOPTIONS_H
@@ -0,0 +1,89 @@
+#include "SearchStats.h"
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * Computes the search speed over the whole search, all threads together.
+ *
+ * @return Positions visited per second, or 0 if no time was measured
+ */
+double SearchStats::nodesPerSecond() const {
+    return elapsed.count() > 0 ? static_cast<double>(nodes) * 1e6 / static_cast<double>(elapsed.count()) : 0.0;
+}
+
+/**
+ * Computes the effective branching factor: the number b with b^depth equal to the positions visited by the
+ * completed iterations. A good move order and a warm table keep it well below the number of legal moves.
+ *
+ * @return The branching factor, or 0 if no iteration completed
+ */
+double SearchStats::branchingFactor() const {
+    std::uint64_t lu_nodes = 0;
+    for (const std::uint64_t lu_iterationNodes : iterationNodes) {
+        lu_nodes += lu_iterationNodes;
+    }
+    if (depth == 0 || lu_nodes == 0) {
+        return 0.0;
+    }
+    return std::pow(static_cast<double>(lu_nodes), 1.0 / depth);
+}
+
+/**
+ * Computes the share of transposition table lookups that found the position.
+ *
+ * @return A fraction between 0 and 1, 0 if the table was never probed
+ */
+double SearchStats::tableHitRate() const {
+    return tableProbes > 0 ? static_cast<double>(tableHits) / static_cast<double>(tableProbes) : 0.0;
+}
+
+/**
+ * Computes the share of cutoffs caused by the first move searched, which measures how well the moves are ordered.
+ *
+ * @return A fraction between 0 and 1, 0 if there were no cutoffs
+ */
+double SearchStats::firstMoveCutoffRate() const {
+    return cutoffs > 0 ? static_cast<double>(firstMoveCutoffs) / static_cast<double>(cutoffs) : 0.0;
+}
+
+/**
+ * Prints the statistics to std::clog: one summary line, and with SEARCH_STATS_ENABLED a line per root move.
+ * A move answered from a table or book only reports where it came from.
+ */
+void SearchStats::print() const {
+    const auto lf_milliseconds = [](const std::chrono::microseconds a_time) { return static_cast<double>(a_time.count()) / 1000.0; };
+    switch (source) {
+        case Source::SOLVED_TABLE:
+            std::clog << "Search: answered from the solved 3x3 table\n";
+            return;
+        case Source::TABLEBASE:
+            std::clog << "Search: answered from the 4x4 tablebase\n";
+            return;
+        case Source::BOOK:
+            std::clog << "Search: answered from the opening book\n";
+            return;
+        case Source::PONDERED:
+            std::clog << "Search (pondered): ";
+            break;
+        case Source::SEARCH:
+            std::clog << "Search: ";
+            break;
+    }
+
+    const std::ios::fmtflags l_flags = std::clog.flags();
+    const std::streamsize li_precision = std::clog.precision();
+    std::clog << std::fixed << std::setprecision(1);
+    std::clog << "depth " << depth << ", value " << value << ", " << nodes << " nodes in " << lf_milliseconds(elapsed) << " ms, "
+              << nodesPerSecond() / 1000.0 << " knps, branching factor " << branchingFactor();
+    if constexpr (SEARCH_STATS_ENABLED) {
+        std::clog << ", table hits " << 100.0 * tableHitRate() << "%, first-move cutoffs " << 100.0 * firstMoveCutoffRate() << "%\n";
+        for (const RootMove& l_rootMove : rootMoves) {
+            std::clog << "  move " << l_rootMove.move << ": " << lf_milliseconds(l_rootMove.time) << " ms, " << l_rootMove.nodes << " nodes\n";
+        }
+    } else {
+        std::clog << "\n";
+    }
+    std::clog.flags(l_flags);
+    std::clog.precision(li_precision);
+}
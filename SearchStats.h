@@ -0,0 +1,57 @@
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Whether AIPlayer counts table probes and cutoffs and times every root move. These counters sit in the
+// innermost loop of the search, so they are only compiled in when the build defines TICTACTOE_SEARCH_STATS
+// (cmake -DTICTACTOE_SEARCH_STATS=ON); otherwise the code that fills them is removed by if constexpr.
+#ifdef TICTACTOE_SEARCH_STATS
+inline constexpr bool SEARCH_STATS_ENABLED = true;
+#else
+inline constexpr bool SEARCH_STATS_ENABLED = false;
+#endif
+
+// What one AIPlayer::findBestMove cost. The totals, depth and time are always kept, since they are
+// gathered once per iteration; the table, cutoff and root move figures stay zero unless SEARCH_STATS_ENABLED.
+struct SearchStats {
+    // Where the move came from
+    enum class Source : std::uint8_t {
+        SEARCH,        // Iterative deepening alpha-beta
+        SOLVED_TABLE,  // The 3x3 table solved at compile time
+        TABLEBASE,     // The 4x4 tablebase
+        BOOK,          // The opening book
+        PONDERED       // A search made on the opponent's time; the figures are those of that search
+    };
+
+    // Cost of one root move, summed over every iteration that searched it
+    struct RootMove {
+        int move = 0;                          // The root move (1 to SIZE)
+        std::chrono::microseconds time{0};     // Time spent below it
+        std::uint64_t nodes = 0;               // Positions visited below it
+    };
+
+    Source source = Source::SEARCH;
+    std::chrono::microseconds elapsed{0};      // Wall-clock time of the search or lookup
+    std::uint64_t nodes = 0;                   // Positions visited by all threads
+    int depth = 0;                             // Depth of the last completed iteration, 0 if none completed
+    int value = 0;                             // Score of the chosen move in that iteration
+    std::vector<std::uint64_t> iterationNodes; // Positions visited by each completed iteration, shallowest first
+
+    std::uint64_t tableProbes = 0;             // Transposition table lookups
+    std::uint64_t tableHits = 0;               // Lookups that found the position
+    std::uint64_t cutoffs = 0;                 // Positions whose search stopped early at a beta cutoff
+    std::uint64_t firstMoveCutoffs = 0;        // Cutoffs caused by the first move tried, a measure of the move order
+    std::vector<RootMove> rootMoves;           // Root moves searched by the main search, in move number order
+
+    // Functions
+    [[nodiscard]] double nodesPerSecond() const;        // Get the search speed, 0 if no time was measured
+    [[nodiscard]] double branchingFactor() const;       // Get the effective branching factor of the completed iterations, 0 if none completed
+    [[nodiscard]] double tableHitRate() const;          // Get the share of table lookups that hit, 0 without lookups
+    [[nodiscard]] double firstMoveCutoffRate() const;   // Get the share of cutoffs caused by the first move, 0 without cutoffs
+    void print() const;                                 // Print the statistics to std::clog
+};
+
+#endif // SEARCHSTATS_H
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "OpeningBook.h"
+#include "ProofSolver.h"
+
+// Proves the value of an empty board offline with the df-pn solver and prints a line of best play.
+// The line can be written as an opening book, so the AI replays it with --book: every position on the
+// line is stored with its proven value and the move of the line.
+// A checkpoint file keeps the solver's tables; a run that is stopped resumes from it when started again
+// with the same board and table size.
+// Usage: TicTacToe_solve <3x3|4x4|5x5|6x6> [table MB] [book file] [checkpoint file]
+
+// Solves one board variant, prints the result, and writes the book; returns the process exit code
+template <typename TBoard>
+int solveBoard(const std::size_t au_megabytes, const std::string& as_bookPath, const std::string& as_checkpointPath) {
+    using Solver = ProofSolver<TBoard>;
+    Solver l_solver(au_megabytes, as_checkpointPath);
+    const auto l_start = std::chrono::steady_clock::now();
+    const typename Solver::Result l_result = l_solver.solve(TBoard{});
+    const double lf_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - l_start).count();
+
+    static constexpr const char* OUTCOME_NAMES[] = {"unknown", "first player wins", "draw", "second player wins"};
+    std::cout << TBoard::ROWS << "x" << TBoard::COLS << ", " << TBoard::WIN_LENGTH << " in a row: "
+              << OUTCOME_NAMES[static_cast<int>(l_result.outcome)] << " (" << l_solver.getNodeCount() << " positions, "
+              << lf_seconds << " s)\nLine:";
+    for (const std::uint8_t lu_move : l_result.line) {
+        std::cout << " " << static_cast<int>(lu_move);
+    }
+    std::cout << "\n";
+
+    if (as_bookPath.empty() || l_result.outcome == Solver::Outcome::UNKNOWN) {
+        return 0;
+    }
+    // Values alternate along the line: the first player's result, then the second player's, and so on
+    std::int32_t li_value = l_result.outcome == Solver::Outcome::WIN ? 1 : l_result.outcome == Solver::Outcome::LOSS ? -1 : 0;
+    std::vector<OpeningBook::Entry> l_entries;
+    TBoard l_board;
+    CellState lc_player = CellState::X;
+    for (const std::uint8_t lu_move : l_result.line) {
+        const auto l_canonical = l_board.canonicalize();
+        const int li_canonicalMove = TBoard::transformMove(lu_move, l_canonical.transform);
+        l_entries.push_back(OpeningBook::Entry{l_canonical.board.getHash(), li_value, static_cast<std::uint8_t>(li_canonicalMove),
+                                               OpeningBook::SOLVED_DEPTH, 0});
+        l_board.pushMove(lc_player, lu_move);
+        lc_player = opponentOf(lc_player);
+        li_value = -li_value;
+    }
+    if (!OpeningBook::write(as_bookPath, TBoard::ROWS, TBoard::COLS, TBoard::WIN_LENGTH, std::move(l_entries))) {
+        std::cerr << "Could not write the book to " << as_bookPath << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << as_bookPath << "\n";
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: TicTacToe_solve <3x3|4x4|5x5|6x6> [table MB] [book file] [checkpoint file]\n";
+        return 1;
+    }
+    const std::string ls_variant = argv[1];
+    const std::size_t lu_megabytes = argc > 2 ? static_cast<std::size_t>(std::max(std::atoll(argv[2]), 1LL)) : 256;
+    const std::string ls_bookPath = argc > 3 ? argv[3] : "";
+    const std::string ls_checkpointPath = argc > 4 ? argv[4] : "";
+
+    if (ls_variant == "3x3") return solveBoard<Board3x3>(lu_megabytes, ls_bookPath, ls_checkpointPath);
+    if (ls_variant == "4x4") return solveBoard<Board4x4>(lu_megabytes, ls_bookPath, ls_checkpointPath);
+    if (ls_variant == "5x5") return solveBoard<Board5x5>(lu_megabytes, ls_bookPath, ls_checkpointPath);
+    if (ls_variant == "6x6") return solveBoard<Board6x6>(lu_megabytes, ls_bookPath, ls_checkpointPath);
+    std::cerr << "Unknown board variant: " << ls_variant << "\n";
+    return 1;
+}
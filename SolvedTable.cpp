@@ -0,0 +1,89 @@
+#include "SolvedTable.h"
+#include <bit>
+
+namespace {
+
+constexpr int WIN_VALUE = 10;  // Value of winning with the move just played, the classic 3x3 minimax scale
+
+using SolvedTable = std::array<SolvedEntry, Board3x3::RANK_COUNT>;
+
+/**
+ * Solves a position with memoized negamax, filling in its table entry and those of every position below it.
+ * A move's value is WIN_VALUE if it wins at once, 0 if it fills the board, and otherwise the negated
+ * value of the reply moved one ply further from the root, which reproduces AIPlayer's depth-adjusted scores.
+ *
+ * @param a_table The table being filled; entries with bestMove == -1 are not solved yet
+ * @param a_board The position to solve, with ac_player to move
+ * @param ac_player The player to move
+ * @return The value of the position for ac_player
+ */
+constexpr int solve(SolvedTable& a_table, const Board3x3& a_board, const CellState ac_player) {
+    SolvedEntry& l_entry = a_table[a_board.rank()];
+    if (l_entry.bestMove != -1) {
+        return l_entry.value;  // Already reached through another move order
+    }
+
+    int li_bestValue = -WIN_VALUE - 1;
+    int li_bestMove = 0;
+    for (int i = 1; i <= Board3x3::SIZE; ++i) {
+        if (!a_board.checkMove(i)) {
+            continue;
+        }
+
+        Board3x3 l_child = a_board;
+        int li_value = 0;
+        if (l_child.makeMove(ac_player, i)) {
+            li_value = WIN_VALUE;                                            // Winning move
+        } else if (!l_child.checkDraw()) {
+            const int li_reply = solve(a_table, l_child, opponentOf(ac_player));
+            li_value = li_reply > 0 ? -li_reply + 1 : (li_reply < 0 ? -li_reply - 1 : 0);  // One ply further away
+        }
+
+        if (li_value > li_bestValue) {  // Strictly better, so ties keep the lowest move like AIPlayer does
+            li_bestValue = li_value;
+            li_bestMove = i;
+        }
+    }
+
+    l_entry = SolvedEntry{static_cast<std::int8_t>(li_bestValue), static_cast<std::int8_t>(li_bestMove)};
+    return li_bestValue;
+}
+
+// Solves the whole game from the empty board. Positions that cannot occur, or where the game is already over,
+// keep bestMove == 0.
+constexpr SolvedTable solveGame() {
+    SolvedTable l_table{};
+    for (auto& entry : l_table) {
+        entry = SolvedEntry{0, -1};
+    }
+    solve(l_table, Board3x3{}, CellState::X);
+    for (auto& entry : l_table) {
+        if (entry.bestMove == -1) {
+            entry = SolvedEntry{0, 0};
+        }
+    }
+    return l_table;
+}
+
+constexpr SolvedTable SOLVED = solveGame();
+
+static_assert(SOLVED[0].value == 0, "Tic-Tac-Toe must be a draw with perfect play");
+static_assert(SOLVED[0].bestMove >= 1 && SOLVED[0].bestMove <= Board3x3::SIZE, "The empty board must have a best move");
+
+} // namespace
+
+const std::array<SolvedEntry, Board3x3::RANK_COUNT> SOLVED_3X3 = SOLVED;
+
+/**
+ * Determines whose turn it is from the number of marks on the board.
+ *
+ * @param a_board The position to inspect
+ * @return X if both players have the same number of marks, O if X has one more, EMPTY otherwise
+ */
+CellState sideToMove(const Board3x3& a_board) {
+    const int li_xCount = std::popcount(a_board.getMask(CellState::X));
+    const int li_oCount = std::popcount(a_board.getMask(CellState::O));
+    if (li_xCount == li_oCount) return CellState::X;
+    if (li_xCount == li_oCount + 1) return CellState::O;
+    return CellState::EMPTY;
+}
@@ -0,0 +1,23 @@
+#ifndef SOLVEDTABLE_H
+#define SOLVEDTABLE_H
+
+#include <array>
+#include <cstdint>
+#include "Board.h"
+
+// Best move and value of one 3x3 position, from the point of view of the player to move.
+// X always moves first, so X is to move when both players have the same number of marks
+// and O is to move when X has one more.
+struct SolvedEntry {
+    std::int8_t value;     // Depth-adjusted minimax value: 10 - plies for a win, -10 + plies for a loss, 0 for a draw, on the classic 3x3 scale, not AIPlayer's
+    std::int8_t bestMove;  // Best move (1-9), the lowest-numbered one among equals; 0 if the game is over or the position cannot occur
+};
+
+// Solution of every 3x3 position, indexed by Board3x3::rank().
+// The table is computed by the compiler, so looking up a move costs a single memory load at run time.
+extern const std::array<SolvedEntry, Board3x3::RANK_COUNT> SOLVED_3X3;
+
+// Returns the player to move in a 3x3 position (X or O), or EMPTY if the mark counts cannot occur in a game
+[[nodiscard]] CellState sideToMove(const Board3x3& a_board);
+
+#endif // SOLVEDTABLE_H
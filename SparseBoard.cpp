@@ -0,0 +1,265 @@
+#include "SparseBoard.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+// Constructor that creates an empty board with the given win length and size
+SparseBoard::SparseBoard(const int ai_winLength, const int ai_size) : m_winLength(ai_winLength), m_size(ai_size) {
+    m_history.reserve(64);  // Most games stay well below this, so the history rarely reallocates
+}
+
+/**
+ * Prints the part of the board around the stones.
+ * A bounded board is printed in full; an unbounded board is printed one cell beyond the bounding region.
+ * Rows and columns are labelled with their coordinates so a move can be read off directly.
+ */
+void SparseBoard::printBoard() const {
+    int li_minRow = 0, li_maxRow = 0, li_minCol = 0, li_maxCol = 0;
+    if (m_size != UNBOUNDED) {
+        li_maxRow = li_maxCol = m_size - 1;
+    } else if (!m_region.isEmpty()) {
+        li_minRow = m_region.minRow - 1;
+        li_maxRow = m_region.maxRow + 1;
+        li_minCol = m_region.minCol - 1;
+        li_maxCol = m_region.maxCol + 1;
+    }
+
+    std::cout << "     ";
+    for (int col = li_minCol; col <= li_maxCol; ++col) {
+        std::cout << std::setw(3) << col;  // Column coordinates
+    }
+    std::cout << "\n";
+
+    for (int row = li_minRow; row <= li_maxRow; ++row) {
+        std::cout << std::setw(4) << row << " ";  // Row coordinate
+        for (int col = li_minCol; col <= li_maxCol; ++col) {
+            std::cout << std::setw(3) << getSymbol(row, col);
+        }
+        std::cout << "\n";
+    }
+}
+
+/**
+ * Places a stone and records it in the history, so it can be taken back with popMove.
+ * Only the chunk of the cell, the neighbour counts around it, and the lines through it are touched.
+ *
+ * @param ac_player The player placing the stone (either X or O)
+ * @param ai_move The packed move of an empty cell
+ * @return true if the stone completed a line of getWinLength() stones, false otherwise
+ */
+bool SparseBoard::pushMove(const CellState ac_player, const Move ai_move) {
+    const int li_row = moveRow(ai_move);
+    const int li_col = moveCol(ai_move);
+
+    setCell(ac_player, li_row, li_col);
+    m_hash ^= stoneKey(ac_player, ai_move);
+    updateNeighbours(li_row, li_col, +1);
+
+    // A new line can only run through the new stone, so only its four directions are scanned
+    static constexpr int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+    bool lb_won = false;
+    for (const auto& direction : directions) {
+        const int li_length = 1 + countDirection(ac_player, li_row, li_col, direction[0], direction[1])
+                                + countDirection(ac_player, li_row, li_col, -direction[0], -direction[1]);
+        if (li_length >= m_winLength) {
+            lb_won = true;
+            break;
+        }
+    }
+    if (lb_won) {
+        ++m_wins[ac_player == CellState::X ? 0 : 1];
+    }
+
+    m_history.push_back(HistoryEntry{ai_move, ac_player, lb_won, m_region});
+
+    // Grow the bounding region to include the new stone
+    if (m_region.isEmpty()) {
+        m_region = Region{li_row, li_row, li_col, li_col};
+    } else {
+        m_region.minRow = std::min(m_region.minRow, li_row);
+        m_region.maxRow = std::max(m_region.maxRow, li_row);
+        m_region.minCol = std::min(m_region.minCol, li_col);
+        m_region.maxCol = std::max(m_region.maxCol, li_col);
+    }
+    return lb_won;
+}
+
+/**
+ * Takes back the most recent stone placed with pushMove, restoring the hash, neighbour counts,
+ * win state, and bounding region.
+ *
+ * @return The packed move that was taken back
+ */
+SparseBoard::Move SparseBoard::popMove() {
+    const HistoryEntry l_entry = m_history.back();
+    m_history.pop_back();
+
+    const int li_row = moveRow(l_entry.move);
+    const int li_col = moveCol(l_entry.move);
+    setCell(CellState::EMPTY, li_row, li_col);
+    m_hash ^= stoneKey(l_entry.player, l_entry.move);
+    updateNeighbours(li_row, li_col, -1);
+
+    if (l_entry.won) {
+        --m_wins[l_entry.player == CellState::X ? 0 : 1];
+    }
+    m_region = l_entry.region;
+    return l_entry.move;
+}
+
+/**
+ * Checks if a player has won the game, i.e. one of their stones completed a line.
+ *
+ * @param ac_player The player to check (either X or O)
+ * @return true if the player has won, false otherwise
+ */
+bool SparseBoard::checkWin(const CellState ac_player) const {
+    if (ac_player == CellState::EMPTY) return false;
+    return m_wins[ac_player == CellState::X ? 0 : 1] > 0;
+}
+
+/**
+ * Checks if the game is a draw. Only a bounded board can fill up; the infinite board never draws.
+ *
+ * @return true if every cell of a bounded board is occupied, false otherwise
+ */
+bool SparseBoard::checkDraw() const {
+    return m_size != UNBOUNDED && getStoneCount() == m_size * m_size;
+}
+
+/**
+ * Checks if a move is valid: the cell must be on the board and empty.
+ *
+ * @param ai_move The packed move to check
+ * @return true if the move is valid, false otherwise
+ */
+bool SparseBoard::checkMove(const Move ai_move) const {
+    const int li_row = moveRow(ai_move);
+    const int li_col = moveCol(ai_move);
+    return isInside(li_row, li_col) && getSymbol(li_row, li_col) == CellState::EMPTY;
+}
+
+/**
+ * Returns the symbol at a specific position on the board. Cells that were never played are EMPTY.
+ *
+ * @param ai_row The row coordinate
+ * @param a_col The column coordinate
+ * @return The symbol (X, O, or EMPTY) at the specified position
+ */
+CellState SparseBoard::getSymbol(const int ai_row, const int a_col) const {
+    const auto l_chunk = m_chunks.find(chunkKey(ai_row, a_col));
+    if (l_chunk == m_chunks.end()) {
+        return CellState::EMPTY;
+    }
+    const int li_bit = ((ai_row & (CHUNK_SIZE - 1)) << CHUNK_BITS) | (a_col & (CHUNK_SIZE - 1));
+    if ((l_chunk->second.xMask >> li_bit) & 1u) return CellState::X;
+    if ((l_chunk->second.oMask >> li_bit) & 1u) return CellState::O;
+    return CellState::EMPTY;
+}
+
+/**
+ * Lists the candidate moves: empty cells within NEIGHBOUR_RADIUS of a stone.
+ * Cells far from every stone are never relevant in k-in-a-row play, so they are skipped entirely.
+ * On an empty board the only candidate is the centre (or the origin of the infinite board).
+ *
+ * @param a_moves Receives the candidate moves; it is cleared first
+ */
+void SparseBoard::generateMoves(std::vector<Move>& a_moves) const {
+    a_moves.clear();
+    if (m_history.empty()) {
+        const int li_centre = m_size == UNBOUNDED ? 0 : m_size / 2;
+        a_moves.push_back(encodeMove(li_centre, li_centre));
+        return;
+    }
+
+    a_moves.reserve(m_neighbours.size());
+    for (const auto& [move, count] : m_neighbours) {
+        if (getSymbol(moveRow(move), moveCol(move)) == CellState::EMPTY) {
+            a_moves.push_back(move);
+        }
+    }
+}
+
+/**
+ * Determines whose turn it is. X moves first and the players alternate.
+ *
+ * @return X after an even number of stones, O after an odd number
+ */
+CellState SparseBoard::getSideToMove() const {
+    return m_history.size() % 2 == 0 ? CellState::X : CellState::O;
+}
+
+// Packs the coordinates of the chunk holding a cell into a hash key
+std::uint32_t SparseBoard::chunkKey(const int ai_row, const int a_col) {
+    const auto lu_chunkRow = static_cast<std::uint16_t>(ai_row >> CHUNK_BITS);
+    const auto lu_chunkCol = static_cast<std::uint16_t>(a_col >> CHUNK_BITS);
+    return (static_cast<std::uint32_t>(lu_chunkRow) << 16) | lu_chunkCol;
+}
+
+// Returns the hash key of one stone, mixed with splitmix64 so neighbouring cells get unrelated keys
+std::uint64_t SparseBoard::stoneKey(const CellState ac_player, const Move ai_move) {
+    std::uint64_t lu_key = static_cast<std::uint32_t>(ai_move) | (static_cast<std::uint64_t>(ac_player) << 32);
+    lu_key += 0x9E3779B97F4A7C15ULL;
+    lu_key = (lu_key ^ (lu_key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    lu_key = (lu_key ^ (lu_key >> 27)) * 0x94D049BB133111EBULL;
+    return lu_key ^ (lu_key >> 31);
+}
+
+// Checks if a cell lies on the board (always true for the infinite board)
+bool SparseBoard::isInside(const int ai_row, const int a_col) const {
+    if (m_size == UNBOUNDED) {
+        return ai_row >= INT16_MIN && ai_row <= INT16_MAX && a_col >= INT16_MIN && a_col <= INT16_MAX;
+    }
+    return ai_row >= 0 && ai_row < m_size && a_col >= 0 && a_col < m_size;
+}
+
+// Counts the player's consecutive stones next to a cell in one direction, up to the win length
+int SparseBoard::countDirection(const CellState ac_player, int ai_row, int a_col, const int ai_dRow, const int ai_dCol) const {
+    int li_count = 0;
+    for (ai_row += ai_dRow, a_col += ai_dCol; li_count < m_winLength - 1; ai_row += ai_dRow, a_col += ai_dCol) {
+        if (getSymbol(ai_row, a_col) != ac_player) {
+            break;
+        }
+        ++li_count;
+    }
+    return li_count;
+}
+
+// Sets or clears one cell, creating its chunk on demand and dropping chunks that become empty
+void SparseBoard::setCell(const CellState ac_player, const int ai_row, const int a_col) {
+    const std::uint32_t lu_key = chunkKey(ai_row, a_col);
+    const std::uint64_t lu_bit = std::uint64_t{1} << (((ai_row & (CHUNK_SIZE - 1)) << CHUNK_BITS) | (a_col & (CHUNK_SIZE - 1)));
+
+    if (ac_player == CellState::EMPTY) {
+        const auto l_chunk = m_chunks.find(lu_key);
+        if (l_chunk == m_chunks.end()) {
+            return;
+        }
+        l_chunk->second.xMask &= ~lu_bit;
+        l_chunk->second.oMask &= ~lu_bit;
+        if ((l_chunk->second.xMask | l_chunk->second.oMask) == 0) {
+            m_chunks.erase(l_chunk);  // Memory only grows with the stones on the board
+        }
+        return;
+    }
+
+    Chunk& l_chunk = m_chunks[lu_key];
+    (ac_player == CellState::X ? l_chunk.xMask : l_chunk.oMask) |= lu_bit;
+}
+
+// Adds ai_delta to the neighbour count of every cell within NEIGHBOUR_RADIUS of a stone
+void SparseBoard::updateNeighbours(const int ai_row, const int a_col, const int ai_delta) {
+    for (int row = ai_row - NEIGHBOUR_RADIUS; row <= ai_row + NEIGHBOUR_RADIUS; ++row) {
+        for (int col = a_col - NEIGHBOUR_RADIUS; col <= a_col + NEIGHBOUR_RADIUS; ++col) {
+            if ((row == ai_row && col == a_col) || !isInside(row, col)) {
+                continue;
+            }
+            const Move lu_move = encodeMove(row, col);
+            if (ai_delta > 0) {
+                m_neighbours[lu_move] += ai_delta;
+            } else if (const auto l_entry = m_neighbours.find(lu_move); l_entry != m_neighbours.end() && (l_entry->second += ai_delta) <= 0) {
+                m_neighbours.erase(l_entry);
+            }
+        }
+    }
+}
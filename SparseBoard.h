@@ -0,0 +1,111 @@
+#ifndef SPARSEBOARD_H
+#define SPARSEBOARD_H
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "CellState.h"
+
+// Class representing a k-in-a-row board for large or unbounded play (e.g. 19x19 Gomoku or the infinite board).
+// Only occupied cells are stored, in 8x8 chunks kept in a hash map, so memory and move generation grow with
+// the number of stones played rather than with the board area.
+// Moves are (row, col) pairs packed into a single integer with encodeMove.
+class SparseBoard {
+public:
+    using Move = std::int32_t;                    // Packed (row, col): row in the high 16 bits, col in the low 16 bits
+
+    static constexpr int NEIGHBOUR_RADIUS = 2;    // Candidate moves lie within this Chebyshev distance of a stone
+    static constexpr int UNBOUNDED = 0;           // Board size meaning "no edges"
+
+    // Smallest rectangle containing every stone, empty when no stone has been played
+    struct Region {
+        int minRow = 0;
+        int maxRow = -1;
+        int minCol = 0;
+        int maxCol = -1;
+
+        [[nodiscard]] bool isEmpty() const { return maxRow < minRow; }
+    };
+
+private:
+    static constexpr int CHUNK_BITS = 3;                  // Chunks are 8x8 cells
+    static constexpr int CHUNK_SIZE = 1 << CHUNK_BITS;
+
+    // One 8x8 block of cells, one bit per cell and player
+    struct Chunk {
+        std::uint64_t xMask = 0;  // Cells occupied by player X
+        std::uint64_t oMask = 0;  // Cells occupied by player O
+    };
+
+    // One entry of the move history: everything needed to take a move back in O(1)
+    struct HistoryEntry {
+        Move move;            // The move that was played
+        CellState player;     // The player who played it
+        bool won;             // Whether the move completed a line
+        Region region;        // The bounding region before the move
+    };
+
+    int m_winLength;                                      // Number of stones in a row needed to win
+    int m_size;                                           // Side length of a bounded board, or UNBOUNDED
+    std::unordered_map<std::uint32_t, Chunk> m_chunks;    // Occupied chunks, keyed by packed chunk coordinates
+    std::unordered_map<Move, int> m_neighbours;           // For cells near stones, how many stones lie within NEIGHBOUR_RADIUS
+    std::vector<HistoryEntry> m_history;                  // Moves played, oldest first
+    Region m_region;                                      // Bounding region of all stones
+    std::array<int, 2> m_wins{};                          // Per-player number of moves in the history that completed a line
+    std::uint64_t m_hash = 0;                             // Zobrist-style hash of the stones on the board
+
+public:
+    // Constructors and destructors
+    // Creates an empty board; ai_size of UNBOUNDED gives the infinite board, otherwise an ai_size x ai_size board
+    explicit SparseBoard(int ai_winLength = 5, int ai_size = UNBOUNDED);
+    ~SparseBoard() = default;  // Default destructor
+
+    // Move encoding
+    [[nodiscard]] static constexpr Move encodeMove(int ai_row, int a_col);  // Pack a (row, col) pair into a move
+    [[nodiscard]] static constexpr int moveRow(Move ai_move);               // Get the row of a packed move
+    [[nodiscard]] static constexpr int moveCol(Move ai_move);               // Get the column of a packed move
+
+    // Functions
+    void printBoard() const;                                          // Method to print the occupied region of the board
+    bool pushMove(CellState ac_player, Move ai_move);                 // Place a stone and record it, returns true if it wins
+    Move popMove();                                                   // Take back the last stone, returns its move
+    [[nodiscard]] bool checkWin(CellState ac_player) const;           // Method to check if a player has won
+    [[nodiscard]] bool checkDraw() const;                             // Method to check if a bounded board is full
+    [[nodiscard]] bool checkMove(Move ai_move) const;                 // Method to check if a move is on the board and empty
+    [[nodiscard]] CellState getSymbol(int ai_row, int a_col) const;   // Get the symbol at a specific board position
+    void generateMoves(std::vector<Move>& a_moves) const;             // List the empty cells near existing stones
+
+    [[nodiscard]] int getWinLength() const { return m_winLength; }
+    [[nodiscard]] int getSize() const { return m_size; }
+    [[nodiscard]] int getStoneCount() const { return static_cast<int>(m_history.size()); }
+    [[nodiscard]] const Region& getRegion() const { return m_region; }
+    [[nodiscard]] std::uint64_t getHash() const { return m_hash; }
+    [[nodiscard]] Move getLastMove() const { return m_history.empty() ? 0 : m_history.back().move; }
+    [[nodiscard]] CellState getSideToMove() const;                    // X on an empty board, then alternating
+
+private:
+    [[nodiscard]] static std::uint32_t chunkKey(int ai_row, int a_col);
+    [[nodiscard]] static std::uint64_t stoneKey(CellState ac_player, Move ai_move);
+    [[nodiscard]] bool isInside(int ai_row, int a_col) const;
+    [[nodiscard]] int countDirection(CellState ac_player, int ai_row, int a_col, int ai_dRow, int ai_dCol) const;
+    void setCell(CellState ac_player, int ai_row, int a_col);
+    void updateNeighbours(int ai_row, int a_col, int ai_delta);
+};
+
+// Move packing is used on every generated move, so it is defined inline here.
+
+constexpr SparseBoard::Move SparseBoard::encodeMove(const int ai_row, const int a_col) {
+    return static_cast<Move>((static_cast<std::uint32_t>(static_cast<std::uint16_t>(ai_row)) << 16) |
+                             static_cast<std::uint16_t>(a_col));
+}
+
+constexpr int SparseBoard::moveRow(const Move ai_move) {
+    return static_cast<std::int16_t>(static_cast<std::uint32_t>(ai_move) >> 16);
+}
+
+constexpr int SparseBoard::moveCol(const Move ai_move) {
+    return static_cast<std::int16_t>(static_cast<std::uint32_t>(ai_move) & 0xFFFFu);
+}
+
+#endif // SPARSEBOARD_H
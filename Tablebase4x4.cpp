@@ -0,0 +1,210 @@
+#include "Tablebase4x4.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include "BatchEvaluator.h"
+#include "ThreadPool.h"
+
+namespace {
+
+using Mask = Board4x4::Mask;
+
+constexpr std::uint8_t OUTCOME_BITS = 0x3;  // Low bits of an entry holding the outcome
+constexpr int DISTANCE_SHIFT = 2;           // The distance is stored above the outcome
+
+// Packs an outcome and a distance into one table entry
+constexpr std::uint8_t encode(const Tablebase4x4::Outcome ac_outcome, const int ai_distance) {
+    return static_cast<std::uint8_t>(static_cast<int>(ac_outcome) | ai_distance << DISTANCE_SHIFT);
+}
+
+// Unpacks a table entry
+constexpr Tablebase4x4::Entry decode(const std::uint8_t au_entry) {
+    return Tablebase4x4::Entry{static_cast<Tablebase4x4::Outcome>(au_entry & OUTCOME_BITS), au_entry >> DISTANCE_SHIFT};
+}
+
+// Base-3 value of a 16-cell mask, i.e. its contribution to a rank when the digit is 1
+constexpr std::uint64_t base3(const Mask au_mask) {
+    return board_detail::BASE3_OF_CHUNK[au_mask & 0xFF] + board_detail::BASE3_OF_CHUNK[au_mask >> 8] * board_detail::RANK_CHUNK_BASE;
+}
+
+// 3^i for every cell: adding it once to a rank places an X on cell i, adding it twice places an O
+constexpr auto CELL_POW3 = [] {
+    std::array<std::uint64_t, Board4x4::SIZE> l_powers{};
+    for (int i = 0; i < Board4x4::SIZE; ++i) {
+        l_powers[i] = board_detail::pow3(i);
+    }
+    return l_powers;
+}();
+
+} // namespace
+
+/**
+ * Solves every position by retrograde analysis. A move only ever adds a mark, so the positions with n marks
+ * depend only on those with n + 1: the table is filled from the full board back to the empty one, one layer
+ * of mark counts at a time. Terminal positions (a line for the player who just moved, or a full board) are
+ * scored directly; every other position takes the best of its children, which are found by adding the new
+ * mark's digit to the rank instead of building boards. Which positions are terminal is decided for all the
+ * X/O splits of an occupied pattern at once, by BatchEvaluator.
+ *
+ * Within a layer the positions are independent, so the occupied-cell patterns of the layer are shared out
+ * over a thread pool. Each thread writes only the entries of its own patterns.
+ *
+ * @param ai_threads The number of threads to use (at least one)
+ */
+void Tablebase4x4::generate(const int ai_threads) {
+    m_entries.assign(Board4x4::RANK_COUNT, encode(Outcome::UNKNOWN, 0));
+
+    // Occupied-cell patterns grouped by the number of marks
+    std::array<std::vector<Mask>, Board4x4::SIZE + 1> l_layers;
+    for (std::uint32_t occupied = 0; occupied <= Board4x4::FULL_MASK; ++occupied) {
+        l_layers[std::popcount(occupied)].push_back(static_cast<Mask>(occupied));
+    }
+
+    // Solves every legal split of one occupied pattern into X and O marks
+    const auto lf_solvePattern = [this](const Mask au_occupied) {
+        const int li_marks = std::popcount(au_occupied);
+        const int li_xCount = (li_marks + 1) / 2;  // X moves first, so X has as many marks as O or one more
+        const bool lb_xToMove = li_marks % 2 == 0;
+        const Mask lu_empty = static_cast<Mask>(Board4x4::FULL_MASK & ~au_occupied);
+
+        BatchEvaluator<Board4x4>::Batch l_splits;
+        for (Mask lu_x = au_occupied;; lu_x = static_cast<Mask>((lu_x - 1) & au_occupied)) {
+            if (std::popcount(lu_x) == li_xCount) {
+                l_splits.add(lu_x, static_cast<Mask>(au_occupied & ~lu_x));
+            }
+            if (lu_x == 0) break;
+        }
+        std::vector<std::uint8_t> l_status;
+        BatchEvaluator<Board4x4>::evaluate(l_splits, l_status);
+        const std::uint8_t lu_toMoveWins = lb_xToMove ? BatchEvaluator<Board4x4>::X_WINS : BatchEvaluator<Board4x4>::O_WINS;
+        const std::uint8_t lu_movedWins = lb_xToMove ? BatchEvaluator<Board4x4>::O_WINS : BatchEvaluator<Board4x4>::X_WINS;
+
+        for (std::size_t i = 0; i < l_splits.size(); ++i) {
+            const std::uint64_t lu_rank = base3(l_splits.x[i]) + 2 * base3(l_splits.o[i]);
+            if (l_status[i] & lu_toMoveWins) {
+                // The game ended before this player's last move, so the position cannot occur
+            } else if (l_status[i] & lu_movedWins) {
+                m_entries[lu_rank] = encode(Outcome::LOSS, 0);
+            } else if (l_status[i] & BatchEvaluator<Board4x4>::DRAW) {
+                m_entries[lu_rank] = encode(Outcome::DRAW, 0);
+            } else {
+                // Win as fast as possible, otherwise draw, otherwise lose as slowly as possible
+                int li_fastestWin = INT32_MAX, li_slowestLoss = -1, li_draw = -1;
+                const std::uint64_t lu_digit = lb_xToMove ? 1 : 2;
+                for (Mask lu_free = lu_empty; lu_free != 0; lu_free = static_cast<Mask>(lu_free & (lu_free - 1))) {
+                    const Entry l_child = decode(m_entries[lu_rank + lu_digit * CELL_POW3[std::countr_zero(lu_free)]]);
+                    if (l_child.outcome == Outcome::LOSS) {
+                        li_fastestWin = std::min(li_fastestWin, l_child.distance + 1);
+                    } else if (l_child.outcome == Outcome::DRAW) {
+                        li_draw = l_child.distance + 1;
+                    } else {
+                        li_slowestLoss = std::max(li_slowestLoss, l_child.distance + 1);
+                    }
+                }
+                m_entries[lu_rank] = li_fastestWin != INT32_MAX ? encode(Outcome::WIN, li_fastestWin)
+                                   : li_draw >= 0 ? encode(Outcome::DRAW, li_draw)
+                                   : encode(Outcome::LOSS, li_slowestLoss);
+            }
+        }
+    };
+
+    ThreadPool l_pool(ai_threads);
+    for (int marks = Board4x4::SIZE; marks >= 0; --marks) {
+        const std::vector<Mask>& l_patterns = l_layers[marks];
+        l_pool.parallelFor(static_cast<int>(l_patterns.size()), [&](const int ai_index, const int) { lf_solvePattern(l_patterns[ai_index]); });
+    }
+}
+
+/**
+ * Reads a tablebase written by save. The file must have the expected header and size.
+ *
+ * @param as_path The file to read
+ * @return true if the table was loaded, false if the file is missing or not a valid tablebase
+ */
+bool Tablebase4x4::load(const std::string& as_path) {
+    std::ifstream l_file(as_path, std::ios::binary);
+    char l_magic[sizeof(FILE_MAGIC)];
+    std::uint32_t lu_version = 0;
+    std::uint64_t lu_count = 0;
+    l_file.read(l_magic, sizeof(l_magic));
+    l_file.read(reinterpret_cast<char*>(&lu_version), sizeof(lu_version));
+    l_file.read(reinterpret_cast<char*>(&lu_count), sizeof(lu_count));
+    if (!l_file || std::memcmp(l_magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || lu_version != FILE_VERSION ||
+        lu_count != Board4x4::RANK_COUNT) {
+        return false;
+    }
+
+    std::vector<std::uint8_t> l_entries(lu_count);
+    l_file.read(reinterpret_cast<char*>(l_entries.data()), static_cast<std::streamsize>(l_entries.size()));
+    if (!l_file) {
+        return false;
+    }
+    m_entries = std::move(l_entries);
+    return true;
+}
+
+/**
+ * Writes the table to a file: an 8-byte magic, the format version, the entry count, and one byte per rank.
+ *
+ * @param as_path The file to write
+ * @return true if the file was written completely, false otherwise
+ */
+bool Tablebase4x4::save(const std::string& as_path) const {
+    std::ofstream l_file(as_path, std::ios::binary | std::ios::trunc);
+    const std::uint64_t lu_count = m_entries.size();
+    l_file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    l_file.write(reinterpret_cast<const char*>(&FILE_VERSION), sizeof(FILE_VERSION));
+    l_file.write(reinterpret_cast<const char*>(&lu_count), sizeof(lu_count));
+    l_file.write(reinterpret_cast<const char*>(m_entries.data()), static_cast<std::streamsize>(m_entries.size()));
+    return static_cast<bool>(l_file);
+}
+
+/**
+ * Looks up the solution of a position.
+ *
+ * @param a_board The position
+ * @return Its outcome for the player to move and the distance to the end of the game
+ */
+Tablebase4x4::Entry Tablebase4x4::probe(const Board4x4& a_board) const {
+    return decode(m_entries[a_board.rank()]);
+}
+
+/**
+ * Picks the best move from the table: the fastest win, otherwise a draw, otherwise the slowest loss,
+ * and the lowest move number among equals. This is the move AIPlayer's full-depth search chooses.
+ *
+ * @param a_board The current game board
+ * @param ac_player The player to move
+ * @return The best move (1-16), or 0 if the game is over or ac_player is not the player to move
+ */
+int Tablebase4x4::findBestMove(const Board4x4& a_board, const CellState ac_player) const {
+    const int li_xCount = std::popcount(a_board.getMask(CellState::X));
+    const int li_oCount = std::popcount(a_board.getMask(CellState::O));
+    const CellState lc_toMove = li_xCount == li_oCount ? CellState::X : CellState::O;
+    if (ac_player != lc_toMove || probe(a_board).outcome == Outcome::UNKNOWN ||
+        a_board.checkWin(CellState::X) || a_board.checkWin(CellState::O) || a_board.checkDraw()) {
+        return 0;
+    }
+
+    const std::uint64_t lu_rank = a_board.rank();
+    const std::uint64_t lu_digit = ac_player == CellState::X ? 1 : 2;
+    int li_bestMove = 0, li_bestScore = INT32_MIN;
+    for (int i = 1; i <= Board4x4::SIZE; ++i) {
+        if (!a_board.checkMove(i)) {
+            continue;
+        }
+        // Scored like AIPlayer: wins count down from 100 with the distance, losses up from -100
+        const Entry l_child = decode(m_entries[lu_rank + lu_digit * CELL_POW3[i - 1]]);
+        const int li_score = l_child.outcome == Outcome::LOSS ? 100 - l_child.distance
+                           : l_child.outcome == Outcome::WIN ? -100 + l_child.distance
+                           : 0;
+        if (li_score > li_bestScore) {
+            li_bestScore = li_score;
+            li_bestMove = i;
+        }
+    }
+    return li_bestMove;
+}
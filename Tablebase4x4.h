@@ -0,0 +1,48 @@
+#ifndef TABLEBASE4X4_H
+#define TABLEBASE4X4_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Board.h"
+
+// Complete solution of the 4x4 board: the result and the distance to the end of the game for every position,
+// indexed by Board4x4::rank(). The 3^16 ranks are too many for a compile-time table like SOLVED_3X3, so the
+// table is generated at run time by retrograde analysis, or loaded from a file written by an earlier run.
+class Tablebase4x4 {
+public:
+    // Result of a position for the player to move, with perfect play from both sides
+    enum class Outcome : std::uint8_t {
+        UNKNOWN,  // The position cannot occur: wrong mark counts, or the player to move already has a line
+        WIN,      // The player to move wins
+        DRAW,     // The board fills up without a winner
+        LOSS      // The opponent wins (or has already won)
+    };
+
+    // One solved position
+    struct Entry {
+        Outcome outcome = Outcome::UNKNOWN;
+        int distance = 0;  // Plies until the game ends: the winner hurries, the loser delays
+    };
+
+private:
+    static constexpr char FILE_MAGIC[8] = {'T', 'T', 'T', '4', 'x', '4', 'T', 'B'};  // Start of a tablebase file
+    static constexpr std::uint32_t FILE_VERSION = 1;                                 // Bumped when the layout changes
+
+    std::vector<std::uint8_t> m_entries;  // Per rank: the outcome in bits 0-1 and the distance in bits 2-6
+
+public:
+    // Constructors and destructors
+    Tablebase4x4() = default;   // Creates an empty tablebase; call generate or load before probing
+    ~Tablebase4x4() = default;  // Default destructor
+
+    // Functions
+    void generate(int ai_threads);                                            // Solve every position, using ai_threads threads
+    bool load(const std::string& as_path);                                    // Read a file written by save, returns false on failure
+    bool save(const std::string& as_path) const;                              // Write the table to a file, returns false on failure
+    [[nodiscard]] bool isReady() const { return !m_entries.empty(); }         // Check if the table was generated or loaded
+    [[nodiscard]] Entry probe(const Board4x4& a_board) const;                 // Get the solution of a position
+    [[nodiscard]] int findBestMove(const Board4x4& a_board, CellState ac_player) const;  // Get the best move, 0 if none
+};
+
+#endif // TABLEBASE4X4_H
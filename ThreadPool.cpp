@@ -0,0 +1,75 @@
+#include "ThreadPool.h"
+
+// Constructor that starts the extra worker threads; they sleep until the first batch
+ThreadPool::ThreadPool(const int ai_threads) {
+    for (int i = 1; i < ai_threads; ++i) {
+        m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+// Destructor that wakes the workers for the last time and waits for them to exit
+ThreadPool::~ThreadPool() {
+    {
+        const std::lock_guard<std::mutex> l_lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& l_thread : m_threads) {
+        l_thread.join();
+    }
+}
+
+/**
+ * Runs a batch of tasks on every thread of the pool, including the caller, and returns once all have finished.
+ * Tasks are taken one at a time in index order, so uneven tasks still keep every thread busy.
+ *
+ * @param ai_count The number of tasks
+ * @param a_task The task to run for every index
+ */
+void ThreadPool::parallelFor(const int ai_count, const Task& a_task) {
+    {
+        const std::lock_guard<std::mutex> l_lock(m_mutex);
+        m_task = &a_task;
+        m_taskCount = ai_count;
+        m_nextTask.store(0, std::memory_order_relaxed);
+        m_busyWorkers = static_cast<int>(m_threads.size());
+        ++m_batch;
+    }
+    m_wake.notify_all();
+
+    runTasks(a_task, ai_count, 0);
+
+    std::unique_lock<std::mutex> l_lock(m_mutex);
+    m_done.wait(l_lock, [this] { return m_busyWorkers == 0; });
+    m_task = nullptr;
+}
+
+// Waits for each new batch, helps running it, and reports back when no tasks are left
+void ThreadPool::workerLoop(const int ai_worker) {
+    std::uint64_t lu_seenBatch = 0;
+    while (true) {
+        std::unique_lock<std::mutex> l_lock(m_mutex);
+        m_wake.wait(l_lock, [&] { return m_stopping || m_batch != lu_seenBatch; });
+        if (m_stopping) {
+            return;
+        }
+        lu_seenBatch = m_batch;
+        const Task* l_task = m_task;
+        const int li_count = m_taskCount;
+        l_lock.unlock();
+
+        runTasks(*l_task, li_count, ai_worker);
+
+        l_lock.lock();
+        if (--m_busyWorkers == 0) {
+            m_done.notify_one();
+        }
+    }
+}
+
+// Takes the next unstarted task until the batch is exhausted
+void ThreadPool::runTasks(const Task& a_task, const int ai_count, const int ai_worker) {
+    for (int i = m_nextTask.fetch_add(1, std::memory_order_relaxed); i < ai_count; i = m_nextTask.fetch_add(1, std::memory_order_relaxed)) {
+        a_task(i, ai_worker);
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads that run a batch of indexed tasks in parallel.
+// The calling thread takes part as worker 0, so a pool of N threads starts N - 1 extra threads.
+// Tasks are handed out in index order, so tasks listed first also start first.
+class ThreadPool {
+public:
+    // Task to run: the task index and the worker running it (0 to getThreadCount() - 1)
+    using Task = std::function<void(int ai_index, int ai_worker)>;
+
+private:
+    std::vector<std::thread> m_threads;     // The extra worker threads (workers 1 to N - 1)
+    std::mutex m_mutex;                     // Guards the batch fields below
+    std::condition_variable m_wake;         // Signals the workers that a batch started or the pool is stopping
+    std::condition_variable m_done;         // Signals the caller that every worker finished the batch
+    const Task* m_task = nullptr;           // Task of the current batch
+    int m_taskCount = 0;                    // Number of tasks in the current batch
+    std::atomic<int> m_nextTask{0};         // Index of the next task to hand out
+    int m_busyWorkers = 0;                  // Extra workers still running the current batch
+    std::uint64_t m_batch = 0;              // Incremented for every batch, so workers notice new work
+    bool m_stopping = false;                // Set by the destructor
+
+public:
+    // Constructors and destructors
+    explicit ThreadPool(int ai_threads);    // Starts ai_threads - 1 worker threads (at least one thread in total)
+    ~ThreadPool();                          // Stops and joins the worker threads
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Functions
+    void parallelFor(int ai_count, const Task& a_task);  // Run tasks 0 to ai_count - 1 and wait until all are done
+    [[nodiscard]] int getThreadCount() const { return static_cast<int>(m_threads.size()) + 1; }
+
+private:
+    void workerLoop(int ai_worker);                      // Body of each extra worker thread
+    void runTasks(const Task& a_task, int ai_count, int ai_worker);  // Take and run tasks until none are left
+};
+
+#endif // THREADPOOL_H
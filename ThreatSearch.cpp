@@ -0,0 +1,245 @@
+#include "ThreatSearch.h"
+#include <algorithm>
+#include <array>
+
+namespace {
+
+constexpr int DIRECTIONS[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};  // Row and column steps of the four line directions
+constexpr int MAX_WIN_LENGTH = 16;                                   // Longest line the window buffer of longestWindow holds
+
+// Prepends a move to a line found further down the tree
+void prependLine(std::vector<ThreatSearch::Move> &a_line, const ThreatSearch::Move ai_move, const std::vector<ThreatSearch::Move> &a_rest) {
+    a_line.clear();
+    a_line.push_back(ai_move);
+    a_line.insert(a_line.end(), a_rest.begin(), a_rest.end());
+}
+
+} // namespace
+
+// Constructor that sets the node budget of every search
+ThreatSearch::ThreatSearch(const std::uint64_t au_nodeLimit) : m_nodeLimit(au_nodeLimit) {}
+
+/**
+ * Finds the best window through an empty cell: of the K-cell windows along the four directions that contain
+ * the cell and no opposing stone or edge, the one holding the most of the player's stones. A result of
+ * K - 1 means the cell completes a line, K - 2 that playing it makes a four.
+ *
+ * @param a_board The current game board
+ * @param ac_player The player whose stones are counted
+ * @param ai_move The empty cell
+ * @return The most stones in an open window, or -1 if every window is blocked
+ */
+int ThreatSearch::longestWindow(const SparseBoard &a_board, const CellState ac_player, const Move ai_move) {
+    const int li_winLength = a_board.getWinLength();
+    const int li_row = SparseBoard::moveRow(ai_move), li_col = SparseBoard::moveCol(ai_move);
+    int li_best = -1;
+
+    for (const auto& direction : DIRECTIONS) {
+        // The 2K - 1 cells centred on the move: +1 for the player's stone, -1 for a blocked cell, 0 for an empty one
+        std::array<int, 2 * MAX_WIN_LENGTH - 1> l_cells{};
+        const int li_span = 2 * li_winLength - 1;
+        for (int i = 0; i < li_span; ++i) {
+            const int li_offset = i - (li_winLength - 1);
+            if (li_offset == 0) continue;  // The cell itself is empty
+            const int li_cellRow = li_row + direction[0] * li_offset, li_cellCol = li_col + direction[1] * li_offset;
+            const CellState lc_cell = a_board.getSymbol(li_cellRow, li_cellCol);
+            if (lc_cell == ac_player) {
+                l_cells[i] = 1;
+            } else if (lc_cell != CellState::EMPTY || !a_board.checkMove(SparseBoard::encodeMove(li_cellRow, li_cellCol))) {
+                l_cells[i] = -1;  // An opposing stone or the edge of the board
+            }
+        }
+        for (int start = 0; start < li_winLength; ++start) {
+            int li_stones = 0;
+            bool lb_open = true;
+            for (int i = start; i < start + li_winLength && lb_open; ++i) {
+                lb_open = l_cells[i] >= 0;
+                li_stones += l_cells[i];
+            }
+            if (lb_open) li_best = std::max(li_best, li_stones);
+        }
+    }
+    return li_best;
+}
+
+/**
+ * Lists the cells that complete a line for a player. Such a cell always touches one of the player's
+ * stones, so only the board's candidate moves need to be checked.
+ *
+ * @param a_board The current game board
+ * @param ac_player The player to check
+ * @param a_cells Receives the completing cells
+ */
+void ThreatSearch::findCompletions(const SparseBoard &a_board, const CellState ac_player, std::vector<Move> &a_cells) {
+    std::vector<Move> l_moves;
+    a_board.generateMoves(l_moves);
+    a_cells.clear();
+    for (const Move li_move : l_moves) {
+        if (longestWindow(a_board, ac_player, li_move) == a_board.getWinLength() - 1) {
+            a_cells.push_back(li_move);
+        }
+    }
+}
+
+/**
+ * Checks if the attacker has a move that makes two fours with different completing cells, or one four
+ * that can be completed at either end. The defender can only block one of them, so a position where this
+ * holds is a threat even without a four on the board: an open three.
+ *
+ * @param a_board The current game board, taken through moves and back
+ * @return true if such a move exists
+ */
+bool ThreatSearch::hasDoubleThreat(SparseBoard &a_board) {
+    std::vector<Move> l_moves, l_completions;
+    a_board.generateMoves(l_moves);
+    for (const Move li_move : l_moves) {
+        if (longestWindow(a_board, m_attacker, li_move) != a_board.getWinLength() - 2) continue;
+        a_board.pushMove(m_attacker, li_move);
+        findCompletions(a_board, m_attacker, l_completions);
+        a_board.popMove();
+        if (l_completions.size() >= 2) return true;
+    }
+    return false;
+}
+
+/**
+ * Searches the attacker's threats. A line the attacker can complete wins at once; a four of the defender
+ * has to be blocked first. Otherwise every move that makes a four or a three is tried, fours first, and
+ * wins if every defender reply to it still loses.
+ *
+ * @param a_board The current game board, with the attacker to move
+ * @param ai_depth How many more threats the attacker may play
+ * @param a_line Receives the winning line from this position
+ * @return true if the attacker wins by force within ai_depth threats
+ */
+bool ThreatSearch::attack(SparseBoard &a_board, const int ai_depth, std::vector<Move> &a_line) {
+    if (++m_nodes > m_nodeLimit) return false;
+
+    std::vector<Move> l_cells;
+    findCompletions(a_board, m_attacker, l_cells);
+    if (!l_cells.empty()) {
+        a_line.assign(1, l_cells.front());
+        return true;
+    }
+
+    std::vector<Move> l_rest;
+    findCompletions(a_board, m_defender, l_cells);
+    if (l_cells.size() >= 2) return false;  // The defender completes a line whatever the attacker blocks
+    if (l_cells.size() == 1) {
+        // Forced to block, which does not use up a threat; the defender moves next against whatever threat remains
+        a_board.pushMove(m_attacker, l_cells.front());
+        const bool lb_won = defend(a_board, ai_depth, l_rest);
+        a_board.popMove();
+        if (lb_won) prependLine(a_line, l_cells.front(), l_rest);
+        return lb_won;
+    }
+
+    if (ai_depth == 0) return false;
+    if (const auto l_refuted = m_refuted.find(a_board.getHash()); l_refuted != m_refuted.end() && l_refuted->second >= ai_depth) {
+        return false;
+    }
+
+    // Threat moves, fours (K - 2 stones in a window before the move) ahead of threes
+    std::vector<Move> l_moves;
+    std::vector<std::pair<int, Move>> l_threats;
+    a_board.generateMoves(l_moves);
+    const int li_winLength = a_board.getWinLength();
+    for (const Move li_move : l_moves) {
+        if (const int li_stones = longestWindow(a_board, m_attacker, li_move); li_stones >= li_winLength - 3) {
+            l_threats.emplace_back(-li_stones, li_move);
+        }
+    }
+    std::sort(l_threats.begin(), l_threats.end());
+
+    for (const auto& [li_order, li_move] : l_threats) {
+        a_board.pushMove(m_attacker, li_move);
+        const bool lb_won = defend(a_board, ai_depth - 1, l_rest);
+        a_board.popMove();
+        if (lb_won) {
+            prependLine(a_line, li_move, l_rest);
+            return true;
+        }
+        if (m_nodes > m_nodeLimit) return false;
+    }
+    m_refuted[a_board.getHash()] = ai_depth;
+    return false;
+}
+
+/**
+ * Checks the defender's replies to a threat. A four has to be blocked on its one completing cell, and two
+ * completing cells cannot both be blocked. Against a three, the only replies that can help are a cell in
+ * one of the attacker's windows with K - 2 stones, which is where its double threat has to come from, or a
+ * four of the defender's own; any other move leaves the double threat in place.
+ *
+ * @param a_board The current game board, with the defender to move
+ * @param ai_depth How many more threats the attacker may play
+ * @param a_line Receives the main line from this position, starting with the defender's reply
+ * @return true if the attacker wins against every reply
+ */
+bool ThreatSearch::defend(SparseBoard &a_board, const int ai_depth, std::vector<Move> &a_line) {
+    if (++m_nodes > m_nodeLimit) return false;
+
+    std::vector<Move> l_cells;
+    findCompletions(a_board, m_defender, l_cells);
+    if (!l_cells.empty()) return false;  // The defender wins first
+
+    std::vector<Move> l_rest;
+    findCompletions(a_board, m_attacker, l_cells);
+    if (l_cells.size() >= 2) {
+        a_line = {l_cells[0], l_cells[1]};  // Whichever cell is blocked, the attacker completes the other
+        return true;
+    }
+    if (l_cells.size() == 1) {
+        a_board.pushMove(m_defender, l_cells.front());
+        const bool lb_won = attack(a_board, ai_depth, l_rest);
+        a_board.popMove();
+        if (lb_won) prependLine(a_line, l_cells.front(), l_rest);
+        return lb_won;
+    }
+    if (ai_depth == 0 || !hasDoubleThreat(a_board)) return false;  // Not a threat, so the defender is free to play anywhere
+
+    std::vector<Move> l_moves;
+    a_board.generateMoves(l_moves);
+    const int li_winLength = a_board.getWinLength();
+    bool lb_first = true;
+    for (const Move li_move : l_moves) {
+        if (longestWindow(a_board, m_attacker, li_move) < li_winLength - 2 && longestWindow(a_board, m_defender, li_move) < li_winLength - 2) {
+            continue;
+        }
+        a_board.pushMove(m_defender, li_move);
+        const bool lb_won = attack(a_board, ai_depth, l_rest);
+        a_board.popMove();
+        if (!lb_won) return false;
+        if (lb_first) prependLine(a_line, li_move, l_rest);
+        lb_first = false;
+    }
+    return !lb_first;
+}
+
+/**
+ * Looks for a forced win of the player to move, allowing one more threat per pass until a win is found,
+ * MAX_DEPTH threats are ruled out, or the node budget is spent.
+ *
+ * @param a_board The current game board
+ * @param a_line Receives the winning line, the attacker's first move first
+ * @return true if a forced win was found
+ */
+bool ThreatSearch::findWin(const SparseBoard &a_board, std::vector<Move> &a_line) {
+    m_nodes = 0;
+    m_refuted.clear();
+    m_attacker = a_board.getSideToMove();
+    m_defender = opponentOf(m_attacker);
+    a_line.clear();
+    if (a_board.getStoneCount() == 0 || a_board.getWinLength() > MAX_WIN_LENGTH || a_board.checkWin(CellState::X) || a_board.checkWin(CellState::O)) {
+        return false;
+    }
+
+    SparseBoard l_board = a_board;
+    for (int depth = 1; depth <= MAX_DEPTH && m_nodes <= m_nodeLimit; ++depth) {
+        if (attack(l_board, depth, a_line)) {
+            return true;
+        }
+    }
+    a_line.clear();
+    return false;
+}
@@ -0,0 +1,55 @@
+#ifndef THREATSEARCH_H
+#define THREATSEARCH_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "SparseBoard.h"
+
+// Threat-space search for k-in-a-row on the sparse board: looks for a win the opponent cannot stop by only
+// playing threats, and only considering the replies that answer them. A four (one stone short of a line)
+// leaves the defender a single reply; a three that can become a double four leaves a handful. Since both
+// trees are tiny compared with the full game tree, forced wins many moves deep are found in milliseconds,
+// where a full-width search would need to reach the same depth over every move.
+// The search is sound: a defender move it does not try leaves the attacker's threat intact.
+class ThreatSearch {
+public:
+    using Move = SparseBoard::Move;
+
+    static constexpr int MAX_DEPTH = 8;                         // Most threats the attacker may play in a row
+    static constexpr std::uint64_t DEFAULT_NODE_LIMIT = 100000;  // Positions visited before the search gives up
+
+private:
+    std::uint64_t m_nodeLimit;                        // Positions allowed per search
+    std::uint64_t m_nodes = 0;                        // Positions visited in the current search
+    CellState m_attacker = CellState::X;              // The player looking for a forced win
+    CellState m_defender = CellState::O;              // The other player
+    std::unordered_map<std::uint64_t, int> m_refuted;  // Attacker-to-move positions without a win, with the depth they were refuted to
+
+    // Function to find the most stones a player has in one open window through an empty cell, or -1 if no window is open
+    [[nodiscard]] static int longestWindow(const SparseBoard &a_board, CellState ac_player, Move ai_move);
+
+    // Function to list the empty cells where a player would complete a line
+    static void findCompletions(const SparseBoard &a_board, CellState ac_player, std::vector<Move> &a_cells);
+
+    // Function to check if the attacker has a move that leaves two different cells completing a line
+    bool hasDoubleThreat(SparseBoard &a_board);
+
+    // Attacker to move: play a threat that wins against every reply, and prepend the line to a_line
+    bool attack(SparseBoard &a_board, int ai_depth, std::vector<Move> &a_line);
+
+    // Defender to move: check that every relevant reply still loses, and prepend the main line to a_line
+    bool defend(SparseBoard &a_board, int ai_depth, std::vector<Move> &a_line);
+
+public:
+    // Constructors and destructors
+    explicit ThreatSearch(std::uint64_t au_nodeLimit = DEFAULT_NODE_LIMIT);  // Creates a search with a node budget
+    ~ThreatSearch() = default;                                              // Default destructor
+
+    // Functions
+    // Find a forced win for the player to move; on success a_line holds the attacker's and defender's moves, attacker first
+    bool findWin(const SparseBoard &a_board, std::vector<Move> &a_line);
+    [[nodiscard]] std::uint64_t getNodeCount() const { return m_nodes; }  // Get the positions visited by the last search
+};
+
+#endif // THREATSEARCH_H
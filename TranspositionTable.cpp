@@ -0,0 +1,98 @@
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <bit>
+#include <climits>
+
+// Constructor that allocates the largest power-of-two number of buckets fitting in au_megabytes (at least one)
+TranspositionTable::TranspositionTable(const std::size_t au_megabytes) {
+    const std::size_t lu_buckets = std::bit_floor(std::max<std::size_t>(au_megabytes * 1024 * 1024 / sizeof(Bucket), 1));
+    m_buckets = std::make_unique<Bucket[]>(lu_buckets);
+    m_bucketMask = lu_buckets - 1;
+}
+
+/**
+ * Looks up the entry stored for a position.
+ * The check word is compared against the key XORed with the data word read with it, so a slot
+ * that another thread is overwriting at the same moment is reported as absent.
+ *
+ * @param au_key The Zobrist hash of the position
+ * @param a_entry Receives the entry if it is found
+ * @return true if the position is in the table, false otherwise
+ */
+bool TranspositionTable::probe(const std::uint64_t au_key, Entry& a_entry) const {
+    const Bucket& l_bucket = m_buckets[au_key & m_bucketMask];
+    for (const Slot& l_slot : l_bucket.slots) {
+        const std::uint64_t lu_data = l_slot.data.load(std::memory_order_relaxed);
+        if ((l_slot.check.load(std::memory_order_relaxed) ^ lu_data) == au_key && lu_data != 0) {  // Empty slots have zero data
+            a_entry = unpack(au_key, lu_data);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Saves a search result. An existing entry for the same position is overwritten; otherwise the
+ * entry from the oldest search is replaced, and among entries of the same age the shallowest one.
+ * Two threads storing into the same slot at once may leave it torn, which only costs the entry.
+ *
+ * @param au_key The Zobrist hash of the position
+ * @param ai_value The search result, already converted with toTableScore
+ * @param ac_bound How the value relates to the true value
+ * @param ai_depth The remaining depth the position was searched to
+ * @param ai_move The best move found, or 0
+ */
+void TranspositionTable::store(const std::uint64_t au_key, const int ai_value, const Bound ac_bound, const int ai_depth, const int ai_move) {
+    Bucket& l_bucket = m_buckets[au_key & m_bucketMask];
+    Slot* l_victim = &l_bucket.slots[0];
+    int li_victimScore = INT32_MAX;
+    for (Slot& l_slot : l_bucket.slots) {
+        const std::uint64_t lu_data = l_slot.data.load(std::memory_order_relaxed);
+        const std::uint64_t lu_key = l_slot.check.load(std::memory_order_relaxed) ^ lu_data;
+        const Entry l_entry = unpack(lu_key, lu_data);
+        if (lu_key == au_key || l_entry.bound == Bound::NONE) {
+            l_victim = &l_slot;
+            break;
+        }
+        // Entries from older searches count as shallower, so stale results make room first
+        const int li_age = static_cast<std::uint8_t>(m_generation - l_entry.generation);
+        const int li_score = l_entry.depth - 8 * li_age;
+        if (li_score < li_victimScore) {
+            li_victimScore = li_score;
+            l_victim = &l_slot;
+        }
+    }
+    const std::uint64_t lu_data = pack(Entry{au_key, ai_value, static_cast<std::uint8_t>(ai_move), ac_bound,
+                                             static_cast<std::int8_t>(ai_depth), m_generation});
+    l_victim->data.store(lu_data, std::memory_order_relaxed);
+    l_victim->check.store(au_key ^ lu_data, std::memory_order_relaxed);
+}
+
+// Forgets every entry, e.g. before starting an unrelated game
+void TranspositionTable::clear() {
+    for (std::size_t i = 0; i <= m_bucketMask; ++i) {
+        for (Slot& l_slot : m_buckets[i].slots) {
+            l_slot.check.store(0, std::memory_order_relaxed);
+            l_slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+// Packs value (bits 0-31), move (32-39), bound (40-47), depth (48-55), and generation (56-63)
+std::uint64_t TranspositionTable::pack(const Entry& a_entry) {
+    return static_cast<std::uint32_t>(a_entry.value)
+         | static_cast<std::uint64_t>(a_entry.move) << 32
+         | static_cast<std::uint64_t>(a_entry.bound) << 40
+         | static_cast<std::uint64_t>(static_cast<std::uint8_t>(a_entry.depth)) << 48
+         | static_cast<std::uint64_t>(a_entry.generation) << 56;
+}
+
+// Reverses pack for the entry of position au_key
+TranspositionTable::Entry TranspositionTable::unpack(const std::uint64_t au_key, const std::uint64_t au_data) {
+    return Entry{au_key,
+                 static_cast<std::int32_t>(static_cast<std::uint32_t>(au_data)),
+                 static_cast<std::uint8_t>(au_data >> 32),
+                 static_cast<Bound>(static_cast<std::uint8_t>(au_data >> 40)),
+                 static_cast<std::int8_t>(static_cast<std::uint8_t>(au_data >> 48)),
+                 static_cast<std::uint8_t>(au_data >> 56)};
+}
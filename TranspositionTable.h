@@ -0,0 +1,96 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Fixed-size cache of search results, keyed by the Zobrist hash of a position.
+// Entries are grouped in buckets of one cache line, so a probe touches a single line of memory.
+// Each AI player owns one table, shared by that player's search threads; each search calls newSearch()
+// so entries left over from earlier moves are replaced first.
+//
+// Several search threads may probe and store at the same time without locks. Each slot keeps the entry
+// packed into one 64-bit word next to the key XORed with that word. A slot torn by two concurrent stores
+// no longer XORs back to its key, so a probe simply misses it instead of returning a corrupt result.
+class TranspositionTable {
+public:
+    // How the stored value relates to the true value of the position
+    enum class Bound : std::uint8_t {
+        NONE,   // Unused slot
+        EXACT,  // The value is exact
+        LOWER,  // The search failed high, the true value is at least this
+        UPPER   // The search failed low, the true value is at most this
+    };
+
+    // One stored search result, as returned by probe. Win and loss scores are kept relative to the position, see toTableScore.
+    struct Entry {
+        std::uint64_t key = 0;          // Full hash of the position, to detect index collisions
+        std::int32_t value = 0;         // Search result, relative to the bound
+        std::uint8_t move = 0;          // Best move found, tried first on the next visit (0 for none)
+        Bound bound = Bound::NONE;      // Kind of bound the value is
+        std::int8_t depth = 0;          // Remaining depth the position was searched to
+        std::uint8_t generation = 0;    // Search that wrote the entry, for the replacement policy
+    };
+
+    static constexpr std::size_t BUCKET_SIZE = 4;  // Entries per bucket: 4 x 16 bytes fill one 64-byte cache line
+
+private:
+    // One entry as stored: the fields after the key packed into data, and the key XORed with data
+    struct Slot {
+        std::atomic<std::uint64_t> check{0};  // key ^ data, verified on every probe
+        std::atomic<std::uint64_t> data{0};   // value, move, bound, depth, and generation packed by pack()
+    };
+
+    struct alignas(64) Bucket {
+        Slot slots[BUCKET_SIZE];
+    };
+
+    static_assert(sizeof(Slot) == 16, "Four entries must fit in one cache line");
+    static_assert(sizeof(Bucket) == 64, "A bucket must be exactly one cache line");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Slots must be updated without locks");
+
+    std::unique_ptr<Bucket[]> m_buckets;  // The table itself
+    std::size_t m_bucketMask = 0;         // Bucket count - 1; the count is a power of two
+    std::uint8_t m_generation = 0;        // Incremented by newSearch
+
+public:
+    // Constructors and destructors
+    explicit TranspositionTable(std::size_t au_megabytes);  // Allocates the largest power-of-two table within the limit
+    ~TranspositionTable() = default;                        // Default destructor
+
+    // Functions
+    [[nodiscard]] bool probe(std::uint64_t au_key, Entry& a_entry) const;                  // Find the entry of a position, false if absent
+    void store(std::uint64_t au_key, int ai_value, Bound ac_bound, int ai_depth, int ai_move);  // Save a search result
+    void newSearch() { ++m_generation; }                                                     // Age the existing entries
+    void clear();                                                                            // Forget every entry
+
+    [[nodiscard]] std::size_t getEntryCount() const { return (m_bucketMask + 1) * BUCKET_SIZE; }
+
+    // Win and loss scores count plies from the root, but a stored entry may be reached from another root.
+    // They are therefore stored as plies from the entry's own position and converted back on the way out.
+    // Any score at or beyond ai_winThreshold (in absolute value) is treated as a win or loss.
+    [[nodiscard]] static constexpr int toTableScore(int ai_value, int ai_ply, int ai_winThreshold);
+    [[nodiscard]] static constexpr int fromTableScore(int ai_value, int ai_ply, int ai_winThreshold);
+
+private:
+    [[nodiscard]] static std::uint64_t pack(const Entry& a_entry);           // Pack the fields after the key into one word
+    [[nodiscard]] static Entry unpack(std::uint64_t au_key, std::uint64_t au_data);  // Rebuild an entry from its key and packed word
+};
+
+// Score conversions run on every probe and store, so they are defined inline here.
+
+constexpr int TranspositionTable::toTableScore(const int ai_value, const int ai_ply, const int ai_winThreshold) {
+    if (ai_value >= ai_winThreshold) return ai_value + ai_ply;
+    if (ai_value <= -ai_winThreshold) return ai_value - ai_ply;
+    return ai_value;
+}
+
+constexpr int TranspositionTable::fromTableScore(const int ai_value, const int ai_ply, const int ai_winThreshold) {
+    if (ai_value >= ai_winThreshold) return ai_value - ai_ply;
+    if (ai_value <= -ai_winThreshold) return ai_value + ai_ply;
+    return ai_value;
+}
+
+#endif // TRANSPOSITIONTABLE_H
@@ -0,0 +1,188 @@
+#include "UltimateAIPlayer.h"
+#include <algorithm>
+#include <bit>
+#include <iostream>
+
+namespace {
+
+constexpr int WIN_SCORE = 100000;         // Winning the game; faster wins score higher
+constexpr int INFINITY_SCORE = 1000000;   // Bound larger than any score
+constexpr int WIN_THRESHOLD = WIN_SCORE - UltimateBoard::SIZE;  // Scores beyond this are wins or losses, stored relative to their position
+
+// Value of holding each meta-board square: centre, then corners, then edges
+constexpr int SQUARE_WEIGHTS[9] = {12, 10, 12, 10, 15, 10, 12, 10, 12};
+
+/**
+ * Scores the position for one player: won sub-boards, meta-board lines still open to them,
+ * and two-in-a-rows inside the sub-boards that are still being played.
+ */
+int scorePlayer(const UltimateBoard &a_board, const CellState ac_player) {
+    const CellState lc_opponent = opponentOf(ac_player);
+    const UltimateBoard::Mask lu_own = a_board.getMetaMask(ac_player);
+    const UltimateBoard::Mask lu_closed = a_board.getMetaMask(CellState::EMPTY);
+    const UltimateBoard::Mask lu_blocked = static_cast<UltimateBoard::Mask>(lu_closed & ~lu_own);  // Won by the opponent or drawn
+    int li_score = 0;
+
+    for (const UltimateBoard::Mask lu_line : Board3x3::WIN_MASKS) {
+        if ((lu_line & lu_blocked) == 0) {
+            const int li_count = std::popcount(static_cast<unsigned>(lu_line & lu_own));
+            li_score += li_count == 2 ? 60 : li_count * 10;  // Open meta-board lines
+        }
+    }
+
+    for (int sub = 0; sub < UltimateBoard::SUB_SIZE; ++sub) {
+        if ((lu_own >> sub) & 1u) {
+            li_score += SQUARE_WEIGHTS[sub] * 10;  // Won sub-board
+        } else if (((lu_closed >> sub) & 1u) == 0) {
+            const UltimateBoard::Mask lu_mine = a_board.getSubMask(sub, ac_player);
+            const UltimateBoard::Mask lu_theirs = a_board.getSubMask(sub, lc_opponent);
+            for (const UltimateBoard::Mask lu_line : Board3x3::WIN_MASKS) {
+                if ((lu_line & lu_theirs) == 0 && std::popcount(static_cast<unsigned>(lu_line & lu_mine)) == 2) {
+                    li_score += SQUARE_WEIGHTS[sub] / 3;  // Threat to win the sub-board
+                }
+            }
+        }
+    }
+    return li_score;
+}
+
+} // namespace
+
+// Constructor that sets the player's symbol and budget and allocates the transposition table
+UltimateAIPlayer::UltimateAIPlayer(const CellState ac_player, const SearchOptions& a_options)
+    : Player(ac_player), m_budget(a_options.moveTime), m_nodeLimit(a_options.nodeLimit != 0 ? a_options.nodeLimit : UINT64_MAX),
+      m_table(a_options.tableMegabytes) {}
+
+/**
+ * Evaluates a position that is not over yet.
+ *
+ * @param a_board The current game board
+ * @return A heuristic score, positive when the player to move stands better
+ */
+int UltimateAIPlayer::evaluateBoard(const UltimateBoard &a_board) const {
+    const CellState lc_toMove = a_board.getSideToMove();
+    return scorePlayer(a_board, lc_toMove) - scorePlayer(a_board, opponentOf(lc_toMove));
+}
+
+/**
+ * Negamax search with alpha-beta pruning and a transposition table.
+ * The search gives up as soon as the time or node budget runs out; the caller then discards the unfinished iteration.
+ *
+ * @param a_board The current game board
+ * @param ai_depth The remaining depth to search
+ * @param ai_ply The distance from the root, used to prefer faster wins
+ * @param ai_alpha The lower bound of the search window
+ * @param ai_beta The upper bound of the search window
+ * @return The value of the position for the player to move
+ */
+int UltimateAIPlayer::negamax(UltimateBoard &a_board, const int ai_depth, const int ai_ply, int ai_alpha, const int ai_beta) {
+    if (++m_nodes >= m_nodeLimit || ((m_nodes & 1023) == 0 && std::chrono::steady_clock::now() >= m_deadline)) {
+        m_aborted = true;  // Out of budget, unwind without trusting the result
+    }
+    if (m_aborted) return 0;
+
+    if (a_board.checkWin(opponentOf(a_board.getSideToMove()))) return -WIN_SCORE + ai_ply;  // The previous move won
+    if (a_board.checkDraw()) return 0;
+    if (ai_depth == 0) return evaluateBoard(a_board);
+
+    // Use a stored result if it was searched deep enough, otherwise just try its best move first
+    const int li_alphaIn = ai_alpha;
+    int li_firstMove = 0;
+    if (TranspositionTable::Entry l_entry; m_table.probe(a_board.getHash(), l_entry)) {
+        li_firstMove = l_entry.move;
+        if (l_entry.depth >= ai_depth) {
+            const int li_value = TranspositionTable::fromTableScore(l_entry.value, ai_ply, WIN_THRESHOLD);
+            if (l_entry.bound == TranspositionTable::Bound::EXACT) return li_value;
+            if (l_entry.bound == TranspositionTable::Bound::LOWER && li_value >= ai_beta) return li_value;
+            if (l_entry.bound == TranspositionTable::Bound::UPPER && li_value <= ai_alpha) return li_value;
+        }
+    }
+
+    std::array<std::uint8_t, UltimateBoard::SIZE> l_moves{};
+    const int li_count = a_board.generateMoves(l_moves);
+    for (int i = 0; i < li_count; ++i) {
+        if (l_moves[i] == li_firstMove) {
+            std::swap(l_moves[0], l_moves[i]);
+            break;
+        }
+    }
+
+    const CellState lc_toMove = a_board.getSideToMove();
+    int li_best = -INFINITY_SCORE;
+    int li_bestMove = l_moves[0];
+    for (int i = 0; i < li_count; ++i) {
+        a_board.pushMove(lc_toMove, l_moves[i]);
+        const int li_value = -negamax(a_board, ai_depth - 1, ai_ply + 1, -ai_beta, -ai_alpha);
+        a_board.popMove();
+        if (m_aborted) return 0;
+
+        if (li_value > li_best) {
+            li_best = li_value;
+            li_bestMove = l_moves[i];
+        }
+        ai_alpha = std::max(ai_alpha, li_value);
+        if (ai_alpha >= ai_beta) break;  // The opponent will avoid this position
+    }
+
+    const TranspositionTable::Bound lc_bound = li_best <= li_alphaIn ? TranspositionTable::Bound::UPPER
+                                             : li_best >= ai_beta ? TranspositionTable::Bound::LOWER
+                                             : TranspositionTable::Bound::EXACT;
+    m_table.store(a_board.getHash(), TranspositionTable::toTableScore(li_best, ai_ply, WIN_THRESHOLD), lc_bound, ai_depth, li_bestMove);
+    return li_best;
+}
+
+/**
+ * Finds the best move within the time budget using iterative deepening.
+ * Each iteration searches one ply deeper, starting from the previous best move; when the deadline
+ * interrupts an iteration, the move from the last completed one is returned.
+ *
+ * @param a_board The current game board
+ * @return The chosen move (1-81)
+ */
+int UltimateAIPlayer::findBestMove(UltimateBoard &a_board) {
+    m_deadline = std::chrono::steady_clock::now() + m_budget;
+    m_nodes = 0;
+    m_aborted = false;
+    m_table.newSearch();
+
+    std::array<std::uint8_t, UltimateBoard::SIZE> l_moves{};
+    const int li_count = a_board.generateMoves(l_moves);
+    int li_bestMove = l_moves[0];  // Always have a legal answer, even if the first iteration is cut short
+
+    for (int depth = 1; depth <= UltimateBoard::SIZE - a_board.getMoveCount(); ++depth) {
+        int li_alpha = -INFINITY_SCORE;
+        int li_iterationMove = li_bestMove;
+
+        // Search the previous best move first so a good bound is available early
+        std::stable_partition(l_moves.begin(), l_moves.begin() + li_count, [li_bestMove](const std::uint8_t move) { return move == li_bestMove; });
+        for (int i = 0; i < li_count; ++i) {
+            a_board.pushMove(m_player, l_moves[i]);
+            const int li_value = -negamax(a_board, depth - 1, 1, -INFINITY_SCORE, -li_alpha);
+            a_board.popMove();
+            if (m_aborted) break;
+            if (li_value > li_alpha) {
+                li_alpha = li_value;
+                li_iterationMove = l_moves[i];
+            }
+        }
+
+        if (m_aborted) break;                         // Keep the move from the last completed iteration
+        li_bestMove = li_iterationMove;
+        if (li_alpha >= WIN_THRESHOLD) break;  // A forced win was found, no need to look deeper
+    }
+    return li_bestMove;
+}
+
+/**
+ * Makes the best move the AI finds within its time budget.
+ *
+ * @param a_board The board where the AI will make its move
+ * @return true if the AI successfully made a move, false otherwise
+ */
+bool UltimateAIPlayer::makeMove(UltimateBoard &a_board) {
+    const int li_bestMove = findBestMove(a_board);  // Get the best move
+
+    a_board.pushMove(m_player, li_bestMove);
+    std::cout << "AI makes a move at position: " << li_bestMove << std::endl;
+    return true;  // Return true to indicate the move was successful
+}
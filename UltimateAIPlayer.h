@@ -0,0 +1,44 @@
+#ifndef ULTIMATEAIPLAYER_H
+#define ULTIMATEAIPLAYER_H
+
+#include <chrono>
+#include <cstdint>
+#include "Player.h"
+#include "SearchOptions.h"
+#include "TranspositionTable.h"
+#include "UltimateBoard.h"
+
+// Class representing an AI player for Ultimate Tic-Tac-Toe.
+// The game tree is far too large for a full minimax, so the AI runs an iterative-deepening alpha-beta search
+// with a transposition table and a heuristic evaluation, and answers with the best move of the last
+// completed iteration once its time budget runs out.
+class UltimateAIPlayer final : public Player<UltimateBoard> {
+public:
+    // Constructor initializes the AI player's symbol, its transposition table, and its time and node budget per move
+    explicit UltimateAIPlayer(CellState ac_player, const SearchOptions& a_options = {});
+
+    // Override the makeMove method to allow the AI player to make a move
+    bool makeMove(UltimateBoard &a_board) override;
+
+    // Override the getSymbol method to return the AI player's symbol (X or O)
+    [[nodiscard]] CellState getSymbol() const override { return m_player; }
+
+    // Function to find the best move that can be found within the time budget
+    int findBestMove(UltimateBoard &a_board);
+
+private:
+    std::chrono::milliseconds m_budget;                       // Thinking time per move
+    std::uint64_t m_nodeLimit;                                // Nodes allowed per move
+    std::chrono::steady_clock::time_point m_deadline;         // When the current search has to stop
+    TranspositionTable m_table;                               // Results of positions already searched
+    std::uint64_t m_nodes = 0;                                // Nodes visited by the current search
+    bool m_aborted = false;                                   // Set when the budget interrupted an iteration
+
+    // Function to evaluate a non-terminal position from the point of view of the player to move
+    [[nodiscard]] int evaluateBoard(const UltimateBoard &a_board) const;
+
+    // Recursive negamax search with alpha-beta pruning, returns the value for the player to move
+    int negamax(UltimateBoard &a_board, int ai_depth, int ai_ply, int ai_alpha, int ai_beta);
+};
+
+#endif // ULTIMATEAIPLAYER_H
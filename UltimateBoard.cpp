@@ -0,0 +1,219 @@
+#include "UltimateBoard.h"
+#include <bit>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * Prints the board as a 9x9 grid, with the sub-boards separated by lines.
+ * Empty cells show their move number, occupied cells show X or O.
+ * Below the grid, the won sub-boards and the forced sub-board are listed.
+ */
+void UltimateBoard::printBoard() const {
+    for (int row = 0; row < 9; ++row) {
+        for (int col = 0; col < 9; ++col) {
+            const int li_subBoard = (row / 3) * 3 + col / 3;
+            const int li_cell = (row % 3) * 3 + col % 3;
+            const CellState lc_cell = cellAt(li_subBoard, li_cell);
+            if (lc_cell == CellState::EMPTY) {
+                std::cout << " " << std::setw(2) << (li_subBoard * SUB_SIZE + li_cell + 1);  // Move number of the empty cell
+            } else {
+                std::cout << " " << std::setw(2) << lc_cell;
+            }
+            if (col == 2 || col == 5) {
+                std::cout << " |";  // Separator between sub-boards
+            }
+        }
+        std::cout << "\n";
+        if (row == 2 || row == 5) {
+            std::cout << "----------+----------+----------\n";
+        }
+    }
+
+    // Summarise the meta-board, since won sub-boards are not visible from the cells alone
+    for (const CellState lc_player : {CellState::X, CellState::O}) {
+        const Mask lu_won = getMetaMask(lc_player);
+        if (lu_won != 0) {
+            std::cout << "Sub-boards won by " << lc_player << ":";
+            for (int i = 0; i < SUB_SIZE; ++i) {
+                if ((lu_won >> i) & 1u) std::cout << " " << (i + 1);
+            }
+            std::cout << "\n";
+        }
+    }
+    const Mask lu_open = getOpenBoards();
+    if (std::popcount(lu_open) == 1) {
+        std::cout << "Next move must be played in sub-board " << (std::countr_zero(lu_open) + 1) << "\n";
+    }
+}
+
+/**
+ * Prints all legal moves, which respect the next-board rule.
+ */
+void UltimateBoard::printAvailableMoves() const {
+    std::array<std::uint8_t, SIZE> l_moves{};
+    const int li_count = generateMoves(l_moves);
+    std::cout << "Available moves: ";
+    for (int i = 0; i < li_count; ++i) {
+        std::cout << "(" << static_cast<int>(l_moves[i]) << ") ";
+    }
+    std::cout << "\n";
+}
+
+/**
+ * Plays a move and records it, so it can be taken back with popMove.
+ * Claims the sub-board on the meta-board if the move wins it, closes it if it fills up,
+ * and sends the opponent to the sub-board matching the cell that was played.
+ *
+ * @param ac_player The player making the move (either X or O)
+ * @param ai_move A legal move number (1-81)
+ * @return true if the move won the game, false otherwise
+ */
+bool UltimateBoard::pushMove(const CellState ac_player, const int ai_move) {
+    const int li_subBoard = (ai_move - 1) / SUB_SIZE;
+    const int li_cell = (ai_move - 1) % SUB_SIZE;
+    const int li_playerIndex = ac_player == CellState::X ? 0 : 1;
+
+    m_history[m_moveCount] = static_cast<std::uint8_t>(ai_move);
+    m_previousNext[m_moveCount] = m_nextBoard;
+    ++m_moveCount;
+
+    m_subBoards[li_subBoard] |= 1u << (li_cell + li_playerIndex * SUB_SIZE);
+    m_hash ^= ZOBRIST_KEYS[ai_move - 1][li_playerIndex];
+
+    // Update the meta-board with the Board3x3 line masks
+    const Mask lu_subBit = static_cast<Mask>(1u << li_subBoard);
+    bool lb_wonGame = false;
+    if (Board3x3::hasWinningLine(getSubMask(li_subBoard, ac_player))) {
+        Mask& lu_meta = ac_player == CellState::X ? m_metaX : m_metaO;
+        lu_meta |= lu_subBit;
+        m_metaClosed |= lu_subBit;
+        lb_wonGame = Board3x3::hasWinningLine(lu_meta);
+    } else if (getSubMask(li_subBoard, CellState::EMPTY) == 0) {
+        m_metaClosed |= lu_subBit;  // Full without a winner
+    }
+
+    // The cell played decides where the opponent goes next
+    if (m_nextBoard != ANY_BOARD) m_hash ^= ZOBRIST_KEYS[SIZE + m_nextBoard][0];
+    m_nextBoard = static_cast<std::int8_t>(((m_metaClosed >> li_cell) & 1u) ? ANY_BOARD : li_cell);
+    if (m_nextBoard != ANY_BOARD) m_hash ^= ZOBRIST_KEYS[SIZE + m_nextBoard][0];
+    return lb_wonGame;
+}
+
+/**
+ * Takes back the most recent move recorded by pushMove.
+ * A closed sub-board cannot change, so the one the move was played in was open before it
+ * and its meta-board bits can simply be cleared.
+ *
+ * @return The move number (1-81) that was taken back
+ */
+int UltimateBoard::popMove() {
+    --m_moveCount;
+    const int li_move = m_history[m_moveCount];
+    const int li_subBoard = (li_move - 1) / SUB_SIZE;
+    const int li_cell = (li_move - 1) % SUB_SIZE;
+    const int li_playerIndex = ((m_subBoards[li_subBoard] >> li_cell) & 1u) ? 0 : 1;
+
+    m_subBoards[li_subBoard] &= ~(1u << (li_cell + li_playerIndex * SUB_SIZE));
+    m_hash ^= ZOBRIST_KEYS[li_move - 1][li_playerIndex];
+
+    const Mask lu_clear = static_cast<Mask>(~(1u << li_subBoard));
+    m_metaX &= lu_clear;
+    m_metaO &= lu_clear;
+    m_metaClosed &= lu_clear;
+
+    if (m_nextBoard != ANY_BOARD) m_hash ^= ZOBRIST_KEYS[SIZE + m_nextBoard][0];
+    m_nextBoard = m_previousNext[m_moveCount];
+    if (m_nextBoard != ANY_BOARD) m_hash ^= ZOBRIST_KEYS[SIZE + m_nextBoard][0];
+    return li_move;
+}
+
+/**
+ * Checks if a player has won the game by claiming three sub-boards in a row.
+ *
+ * @param ac_player The player to check (either X or O)
+ * @return true if the player has won, false otherwise
+ */
+bool UltimateBoard::checkWin(const CellState ac_player) const {
+    return ac_player != CellState::EMPTY && Board3x3::hasWinningLine(getMetaMask(ac_player));
+}
+
+/**
+ * Checks if the game is a draw: every sub-board is closed and nobody has three in a row.
+ *
+ * @return true if the game is a draw, false otherwise
+ */
+bool UltimateBoard::checkDraw() const {
+    return m_metaClosed == Board3x3::FULL_MASK && !checkWin(CellState::X) && !checkWin(CellState::O);
+}
+
+/**
+ * Checks if a move is legal: the cell must be empty and lie in a sub-board the next move may be played in.
+ *
+ * @param ai_move The move number (1-81) to check
+ * @return true if the move is legal, false otherwise
+ */
+bool UltimateBoard::checkMove(const int ai_move) const {
+    if (ai_move < 1 || ai_move > SIZE) {
+        return false;
+    }
+    const int li_subBoard = (ai_move - 1) / SUB_SIZE;
+    const int li_cell = (ai_move - 1) % SUB_SIZE;
+    return ((getOpenBoards() >> li_subBoard) & 1u) && ((getSubMask(li_subBoard, CellState::EMPTY) >> li_cell) & 1u);
+}
+
+/**
+ * Lists the legal moves by walking the free-cell masks of the playable sub-boards.
+ * Only set bits are visited, so the cost is proportional to the number of legal moves.
+ *
+ * @param a_moves Receives the legal move numbers (1-81) in increasing order
+ * @return The number of legal moves written to a_moves
+ */
+int UltimateBoard::generateMoves(std::array<std::uint8_t, SIZE>& a_moves) const {
+    int li_count = 0;
+    for (Mask lu_boards = getOpenBoards(); lu_boards != 0; lu_boards &= static_cast<Mask>(lu_boards - 1)) {
+        const int li_subBoard = std::countr_zero(lu_boards);
+        for (Mask lu_free = getSubMask(li_subBoard, CellState::EMPTY); lu_free != 0; lu_free &= static_cast<Mask>(lu_free - 1)) {
+            a_moves[li_count++] = static_cast<std::uint8_t>(li_subBoard * SUB_SIZE + std::countr_zero(lu_free) + 1);
+        }
+    }
+    return li_count;
+}
+
+/**
+ * Returns one sub-board as a regular Board3x3, e.g. for display or analysis with the 3x3 tools.
+ *
+ * @param ai_subBoard The sub-board index (0-8)
+ * @return A Board3x3 holding the same marks
+ */
+Board3x3 UltimateBoard::getSubBoard(const int ai_subBoard) const {
+    return Board3x3::fromMasks(getSubMask(ai_subBoard, CellState::X), getSubMask(ai_subBoard, CellState::O));
+}
+
+/**
+ * Returns the meta-board squares of a player.
+ *
+ * @param ac_player X or O for the sub-boards they won, EMPTY for every closed sub-board
+ * @return A 9-bit mask of sub-boards
+ */
+UltimateBoard::Mask UltimateBoard::getMetaMask(const CellState ac_player) const {
+    if (ac_player == CellState::X) return m_metaX;
+    if (ac_player == CellState::O) return m_metaO;
+    return m_metaClosed;
+}
+
+/**
+ * Determines whose turn it is. X moves first and the players alternate.
+ *
+ * @return X after an even number of moves, O after an odd number
+ */
+CellState UltimateBoard::getSideToMove() const {
+    return m_moveCount % 2 == 0 ? CellState::X : CellState::O;
+}
+
+// Returns the symbol in one cell of a sub-board
+CellState UltimateBoard::cellAt(const int ai_subBoard, const int ai_cell) const {
+    const std::uint32_t lu_packed = m_subBoards[ai_subBoard];
+    if ((lu_packed >> ai_cell) & 1u) return CellState::X;
+    if ((lu_packed >> (ai_cell + SUB_SIZE)) & 1u) return CellState::O;
+    return CellState::EMPTY;
+}
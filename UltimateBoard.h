@@ -0,0 +1,102 @@
+#ifndef ULTIMATEBOARD_H
+#define ULTIMATEBOARD_H
+
+#include <array>
+#include <cstdint>
+#include "Board.h"
+#include "CellState.h"
+
+// Class representing an Ultimate Tic-Tac-Toe board: a 3x3 grid of 3x3 sub-boards.
+// The cell a player picks inside a sub-board decides which sub-board the opponent must play in next;
+// if that sub-board is already won or full, the opponent may play in any open sub-board.
+// Winning a sub-board claims its square on the meta-board, and three claimed squares in a row win the game.
+//
+// The whole state is packed into bitmasks: each sub-board takes 18 bits (9 for X, 9 for O) and the
+// meta-board keeps 9-bit masks of the squares won by each player and of the closed sub-boards.
+// Win and draw detection on both levels reuses the Board3x3 line masks.
+// Moves are numbered 1-81: move = subBoard * 9 + cell + 1, with both indices counted row by row.
+class UltimateBoard {
+public:
+    static constexpr int SUB_SIZE = Board3x3::SIZE;   // Cells per sub-board (and sub-boards per game)
+    static constexpr int SIZE = SUB_SIZE * SUB_SIZE;  // Total number of cells on the board
+    static constexpr int ANY_BOARD = -1;              // The next player may choose any open sub-board
+
+    static constexpr const char* VARIANT_NAME = "Ultimate Tic-Tac-Toe";  // Shown in the game header
+
+    using Mask = Board3x3::Mask;                      // 9-bit mask of a sub-board or of the meta-board
+
+    // Zobrist keys: one per (cell, player) and, after the cells, one per forced sub-board
+    static constexpr auto ZOBRIST_KEYS = board_detail::makeZobristKeys<SIZE + SUB_SIZE>();
+
+private:
+    std::array<std::uint32_t, SUB_SIZE> m_subBoards{};  // Per sub-board: X cells in bits 0-8, O cells in bits 9-17
+    Mask m_metaX = 0;                                    // Sub-boards won by X
+    Mask m_metaO = 0;                                    // Sub-boards won by O
+    Mask m_metaClosed = 0;                               // Sub-boards that are won or full
+    std::int8_t m_nextBoard = ANY_BOARD;                 // Sub-board the next move must be played in, or ANY_BOARD
+    std::uint64_t m_hash = 0;                            // Zobrist hash of the stones and the forced sub-board
+
+    std::array<std::uint8_t, SIZE> m_history{};          // Moves (1-81) played through pushMove, oldest first
+    std::array<std::int8_t, SIZE> m_previousNext{};      // m_nextBoard before each recorded move
+    int m_moveCount = 0;                                 // Number of valid entries in m_history
+
+public:
+    // Constructors and destructors
+    UltimateBoard() = default;   // Constructor to initialize an empty board
+    ~UltimateBoard() = default;  // Default destructor
+
+    // Functions
+    void printBoard() const;                                              // Method to print the current state of the board
+    void printAvailableMoves() const;                                     // Method to print the available moves
+    bool pushMove(CellState ac_player, int ai_move);                      // Play a move and record it, returns true if it wins the game
+    int popMove();                                                        // Take back the last recorded move, returns its move number
+    [[nodiscard]] bool checkWin(CellState ac_player) const;               // Method to check if a player has won the meta-board
+    [[nodiscard]] bool checkDraw() const;                                 // Method to check if the game ended without a winner
+    [[nodiscard]] bool checkMove(int ai_move) const;                      // Method to check if a move is legal, including the next-board rule
+    int generateMoves(std::array<std::uint8_t, SIZE>& a_moves) const;     // List the legal moves, returns how many there are
+
+    [[nodiscard]] Mask getSubMask(int ai_subBoard, CellState ac_player) const;  // Get a player's cells in one sub-board
+    [[nodiscard]] Board3x3 getSubBoard(int ai_subBoard) const;                  // Get one sub-board as a regular Board3x3
+    [[nodiscard]] Mask getMetaMask(CellState ac_player) const;                  // Get the sub-boards won by a player (EMPTY: closed ones)
+    [[nodiscard]] int getNextBoard() const { return m_nextBoard; }              // Get the forced sub-board, or ANY_BOARD
+    [[nodiscard]] Mask getOpenBoards() const;                                   // Get the sub-boards the next move may be played in
+    [[nodiscard]] CellState getSideToMove() const;                              // X on an empty board, then alternating
+    [[nodiscard]] int getMoveCount() const { return m_moveCount; }
+    [[nodiscard]] std::uint64_t getHash() const { return m_hash; }
+
+private:
+    [[nodiscard]] CellState cellAt(int ai_subBoard, int ai_cell) const;   // Get the symbol at a sub-board cell
+};
+
+/**
+ * Returns the sub-boards the next move may be played in: the forced one if it is still open,
+ * otherwise every open sub-board. No sub-board is open once the meta-board has been won.
+ *
+ * @return A 9-bit mask of playable sub-boards
+ */
+inline UltimateBoard::Mask UltimateBoard::getOpenBoards() const {
+    if (Board3x3::hasWinningLine(m_metaX) || Board3x3::hasWinningLine(m_metaO)) {
+        return 0;  // The game is over
+    }
+    const Mask lu_open = static_cast<Mask>(Board3x3::FULL_MASK & ~m_metaClosed);
+    if (m_nextBoard != ANY_BOARD && ((lu_open >> m_nextBoard) & 1u)) {
+        return static_cast<Mask>(1u << m_nextBoard);
+    }
+    return lu_open;
+}
+
+/**
+ * Returns a player's cells in one sub-board.
+ *
+ * @param ai_subBoard The sub-board index (0-8)
+ * @param ac_player The player to query (X or O), or EMPTY for the free cells
+ * @return A 9-bit mask in the same layout as Board3x3
+ */
+inline UltimateBoard::Mask UltimateBoard::getSubMask(const int ai_subBoard, const CellState ac_player) const {
+    const std::uint32_t lu_packed = m_subBoards[ai_subBoard];
+    if (ac_player == CellState::X) return static_cast<Mask>(lu_packed & Board3x3::FULL_MASK);
+    if (ac_player == CellState::O) return static_cast<Mask>((lu_packed >> SUB_SIZE) & Board3x3::FULL_MASK);
+    return static_cast<Mask>(Board3x3::FULL_MASK & ~(lu_packed | (lu_packed >> SUB_SIZE)));
+}
+
+#endif // ULTIMATEBOARD_H
@@ -1,7 +1,95 @@
 #include "Game.h"
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include "MCTSPlayer.h"
+#include "OpeningBook.h"
+#include "QubicAIPlayer.h"
+#include "Tablebase4x4.h"
+#include "UltimateAIPlayer.h"
+
+// Creates and runs a game on the selected board variant
+template <typename TBoard, typename TAIPlayer = AIPlayer<TBoard>>
+void playGame(const GameMode am_mode, const SearchOptions& a_options) {
+    Game<TBoard, TAIPlayer> game(am_mode, a_options);  // Create a Game object with the chosen game mode
+    game.play();                                       // Start the game by calling the play method
+}
+
+// Loads the 4x4 tablebase from a file, or generates it and writes the file if it does not exist yet
+std::shared_ptr<const Tablebase4x4> openTablebase(const std::string& as_path, const int ai_threads) {
+    auto l_tablebase = std::make_shared<Tablebase4x4>();
+    if (l_tablebase->load(as_path)) {
+        return l_tablebase;
+    }
+    std::cout << "Generating the 4x4 tablebase, this takes a moment...\n";
+    l_tablebase->generate(ai_threads);
+    if (!l_tablebase->save(as_path)) {
+        std::cerr << "Could not write the tablebase to " << as_path << "\n";
+    }
+    return l_tablebase;
+}
+
+// Reads the AI settings from the command line, e.g. "--hash 64" for a 64 MB transposition table.
+// Every option except the --lazy-smp and --stats switches and the --tablebase and --book files takes a positive number. Unknown or malformed options are reported and otherwise ignored.
+SearchOptions parseOptions(const int ai_argc, char* a_argv[]) {
+    SearchOptions l_options;
+    std::string ls_tablebasePath;
+    for (int i = 1; i < ai_argc; ++i) {
+        const std::string ls_option = a_argv[i];
+        if (ls_option == "--lazy-smp") {
+            l_options.lazySmp = true;
+            continue;
+        }
+        if (ls_option == "--stats") {
+            l_options.logStats = true;
+            continue;
+        }
+        if (ls_option == "--tablebase" && i + 1 < ai_argc) {
+            ls_tablebasePath = a_argv[++i];
+            continue;
+        }
+        if (ls_option == "--book" && i + 1 < ai_argc) {
+            auto l_book = std::make_shared<OpeningBook>();
+            if (l_book->open(a_argv[++i])) {
+                l_options.book = std::move(l_book);
+            } else {
+                std::cerr << "Ignoring missing or invalid opening book: " << a_argv[i] << "\n";
+            }
+            continue;
+        }
+        const long long li_value = i + 1 < ai_argc ? std::strtoll(a_argv[i + 1], nullptr, 10) : 0;
+        if (li_value <= 0) {
+            std::cerr << "Ignoring invalid option: " << ls_option << "\n";
+            continue;
+        }
+        if (ls_option == "--hash") {
+            l_options.tableMegabytes = static_cast<std::size_t>(li_value);
+        } else if (ls_option == "--movetime") {
+            l_options.moveTime = std::chrono::milliseconds(li_value);
+        } else if (ls_option == "--nodes") {
+            l_options.nodeLimit = static_cast<std::uint64_t>(li_value);
+        } else if (ls_option == "--depth") {
+            l_options.maxDepth = static_cast<int>(li_value);
+        } else if (ls_option == "--threads") {
+            l_options.threads = static_cast<int>(li_value);
+        } else {
+            std::cerr << "Ignoring invalid option: " << ls_option << "\n";
+            continue;
+        }
+        ++i;  // Skip the value
+    }
+
+    // Opened last, so the generator can use the --threads given anywhere on the command line
+    if (!ls_tablebasePath.empty()) {
+        l_options.tablebase4x4 = openTablebase(ls_tablebasePath, l_options.threads);
+    }
+    return l_options;
+}
+
+int main(int argc, char* argv[]) {
+    const SearchOptions options = parseOptions(argc, argv);
 
-int main() {
     // Prompt the user to select the game mode
     std::cout << "Select game mode:\n";
     std::cout << "1. Human vs. AI\n";
@@ -23,11 +111,46 @@ int main() {
         mode = GameMode::HumanVsAI;
     }
 
-    // Create a Game object with the chosen game mode
-    Game game(mode);
+    // Prompt the user to select the board variant
+    std::cout << "Select board:\n";
+    std::cout << "1. 3x3, three in a row\n";
+    std::cout << "2. 4x4, four in a row\n";
+    std::cout << "3. 5x5, four in a row\n";
+    std::cout << "4. 7x7, five in a row\n";
+    std::cout << "5. Ultimate Tic-Tac-Toe\n";
+    std::cout << "6. Qubic (4x4x4), four in a row\n";
+    std::cout << "7. Ultimate Tic-Tac-Toe against Monte Carlo tree search\n";
+    int boardChoice;
+    std::cin >> boardChoice;
 
-    // Start the game by calling the play method
-    game.play();
+    // Each variant is its own Game instantiation with the board size fixed at compile time
+    switch (boardChoice) {
+        case 2:
+            playGame<Board4x4>(mode, options);
+            break;
+        case 3:
+            playGame<Board5x5>(mode, options);
+            break;
+        case 4:
+            playGame<Board7x7>(mode, options);
+            break;
+        case 5:
+            playGame<UltimateBoard, UltimateAIPlayer>(mode, options);
+            break;
+        case 6:
+            playGame<QubicBoard, QubicAIPlayer>(mode, options);
+            break;
+        case 7:
+            playGame<UltimateBoard, MCTSPlayer<UltimateBoard>>(mode, options);
+            break;
+        default:
+            if (boardChoice != 1) {
+                // If the input is invalid, print an error and default to the classic board
+                std::cerr << "Invalid choice! Defaulting to 3x3.\n";
+            }
+            playGame<Board3x3>(mode, options);
+            break;
+    }
 
     return 0;
 }